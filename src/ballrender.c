@@ -0,0 +1,49 @@
+#include "ballrender.h"
+#include "rlgl.h"
+
+#define QUADS_PER_CHUNK 1024   // quadrados entre verificações do limite do lote
+
+int ballRendererInit(BallRenderer *renderer, float radius) {
+    int size = (int)(radius * 2.0f) + 2;
+    Image image = GenImageColor(size, size, BLANK);
+    ImageDrawCircle(&image, size / 2, size / 2, (int)radius, WHITE);
+    renderer->sprite = LoadTextureFromImage(image);
+    UnloadImage(image);
+    renderer->radius = radius;
+    if (renderer->sprite.id == 0) return -1;
+    SetTextureFilter(renderer->sprite, TEXTURE_FILTER_BILINEAR);
+    return 0;
+}
+
+void ballRendererFree(BallRenderer *renderer) {
+    if (renderer->sprite.id != 0) UnloadTexture(renderer->sprite);
+    renderer->sprite.id = 0;
+}
+
+int ballRendererDraw(const BallRenderer *renderer, const float *x, const float *y, int count, Color color) {
+    if (count <= 0) return 0;
+    // O quadrado cobre a textura inteira, que tem um pixel de margem em
+    // volta do círculo
+    float half = renderer->sprite.width / 2.0f;
+
+    rlSetTexture(renderer->sprite.id);
+    for (int begin = 0; begin < count; begin += QUADS_PER_CHUNK) {
+        int end = begin + QUADS_PER_CHUNK < count ? begin + QUADS_PER_CHUNK : count;
+        // Se o lote atual não comporta o pedaço inteiro ele é enviado antes
+        rlCheckRenderBatchLimit(4 * (end - begin));
+        rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = begin; i < end; i++) {
+            float x0 = x[i] - half, y0 = y[i] - half;
+            float x1 = x[i] + half, y1 = y[i] + half;
+            rlTexCoord2f(0.0f, 0.0f); rlVertex2f(x0, y0);
+            rlTexCoord2f(0.0f, 1.0f); rlVertex2f(x0, y1);
+            rlTexCoord2f(1.0f, 1.0f); rlVertex2f(x1, y1);
+            rlTexCoord2f(1.0f, 0.0f); rlVertex2f(x1, y0);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+    return count;
+}
@@ -0,0 +1,26 @@
+#ifndef BALLRENDER_H
+#define BALLRENDER_H
+
+#include "raylib.h"
+
+// Desenho de muitas bolas de uma vez. Em vez de um DrawCircle por bola
+// (dezenas de triângulos cada), cada bola vira um quadrado com a textura
+// de um círculo, e todos entram no mesmo lote do rlgl com a mesma textura.
+// O custo por bola é escrever 4 vértices; o lote só é enviado à GPU quando
+// enche (RL_DEFAULT_BATCH_BUFFER_ELEMENTS quadrados) ou no fim do frame.
+
+typedef struct {
+    Texture2D sprite;   // círculo branco (a cor vem do vértice)
+    float     radius;
+} BallRenderer;
+
+// Precisa da janela aberta. Retorna 0 em caso de sucesso, -1 se não
+// conseguiu criar a textura.
+int  ballRendererInit(BallRenderer *renderer, float radius);
+void ballRendererFree(BallRenderer *renderer);
+
+// Desenha 'count' bolas com centro em (x[i], y[i]).
+// Retorna quantas bolas foram desenhadas (para o contador de itens do profiler.c).
+int  ballRendererDraw(const BallRenderer *renderer, const float *x, const float *y, int count, Color color);
+
+#endif
@@ -0,0 +1,449 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ballstore.h"
+
+// -DBALLSTORE_NO_SIMD força o kernel escalar (útil para comparar resultados)
+#if !defined(BALLSTORE_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define BALLSTORE_X86 1
+#include <immintrin.h>
+#endif
+
+// Os kernels só olham o pino mais próximo da bola. Isso equivale à busca
+// em galton.c enquanto dois pinos vizinhos não puderem tocar a bola ao
+// mesmo tempo, ou seja, enquanto o espaçamento for >= 2 * distância mínima.
+#if PIN_SPACING < 2 * (BALL_RADIUS + PIN_RADIUS)
+#error "ballstore.c assume PIN_SPACING >= 2 * (BALL_RADIUS + PIN_RADIUS)"
+#endif
+
+static void *alignedAlloc(size_t size) {
+#ifdef _WIN32
+    return _aligned_malloc(size, BALLSTORE_ALIGN);
+#else
+    void *p = NULL;
+    if (posix_memalign(&p, BALLSTORE_ALIGN, size) != 0) return NULL;
+    return p;
+#endif
+}
+
+static void alignedFree(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+int ballStoreInit(BallStore *store, int capacity) {
+    capacity = (capacity + BALLSTORE_LANES - 1) / BALLSTORE_LANES * BALLSTORE_LANES;
+    if (capacity < BALLSTORE_LANES) capacity = BALLSTORE_LANES;
+
+    memset(store, 0, sizeof(*store));
+    store->capacity  = capacity;
+    store->x         = alignedAlloc(sizeof(float) * capacity);
+    store->y         = alignedAlloc(sizeof(float) * capacity);
+    store->vx        = alignedAlloc(sizeof(float) * capacity);
+    store->vy        = alignedAlloc(sizeof(float) * capacity);
+    store->active    = alignedAlloc(sizeof(int) * capacity);
+    store->slotIndex = alignedAlloc(sizeof(int) * capacity);
+    if (!store->x || !store->y || !store->vx || !store->vy || !store->active || !store->slotIndex) {
+        ballStoreFree(store);
+        return -1;
+    }
+    ballStoreClear(store);
+    return 0;
+}
+
+void ballStoreFree(BallStore *store) {
+    alignedFree(store->x);
+    alignedFree(store->y);
+    alignedFree(store->vx);
+    alignedFree(store->vy);
+    alignedFree(store->active);
+    alignedFree(store->slotIndex);
+    memset(store, 0, sizeof(*store));
+}
+
+void ballStoreClear(BallStore *store) {
+    // Zera tudo, inclusive as posições de sobra do último bloco: os kernels
+    // processam blocos inteiros e dependem de active == 0 nelas.
+    memset(store->x,         0, sizeof(float) * store->capacity);
+    memset(store->y,         0, sizeof(float) * store->capacity);
+    memset(store->vx,        0, sizeof(float) * store->capacity);
+    memset(store->vy,        0, sizeof(float) * store->capacity);
+    memset(store->active,    0, sizeof(int) * store->capacity);
+    memset(store->slotIndex, 0, sizeof(int) * store->capacity);
+    store->count = 0;
+    store->jitterLeft = 0;
+}
+
+void ballStoreSet(BallStore *store, int i, const Ball *ball) {
+    store->x[i]         = ball->x;
+    store->y[i]         = ball->y;
+    store->vx[i]        = ball->vx;
+    store->vy[i]        = ball->vy;
+    store->active[i]    = ball->active;
+    store->slotIndex[i] = ball->slotIndex;
+}
+
+static void spawnAt(BallStore *store, const GaltonBoard *board, int i) {
+    Ball ball;
+    galtonSpawnBall(board, &ball);
+    ballStoreSet(store, i, &ball);
+}
+
+int ballStoreSpawn(BallStore *store, const GaltonBoard *board) {
+    if (store->count >= store->capacity) return -1;
+    int i = store->count++;
+    spawnAt(store, board, i);
+    return i;
+}
+
+int ballStoreAdd(BallStore *store, const Ball *ball) {
+    if (store->count >= store->capacity) return -1;
+    int i = store->count++;
+    ballStoreSet(store, i, ball);
+    return i;
+}
+
+#ifndef BALLSTORE_X86
+// ----- Kernel escalar (fallback e referência) -----
+// Passa cada bola pelo próprio galtonStepBall(), então é idêntico ao jogo.
+static int stepScalar(BallStore *s, const GaltonBoard *board, float dt, Rng *rng, int begin, int end, unsigned long long *slotCounts) {
+    int landed = 0;
+    for (int i = begin; i < end; i++) {
+        if (!s->active[i]) continue;
+        Ball ball = { s->x[i], s->y[i], s->vx[i], s->vy[i], s->active[i], s->slotIndex[i] };
+        s->pinTests += galtonPinTests(board, &ball);
+        if (galtonStepBall(board, &ball, dt, rng)) {
+            landed++;
+            if (slotCounts) slotCounts[ball.slotIndex]++;
+        }
+        s->x[i] = ball.x;   s->y[i] = ball.y;
+        s->vx[i] = ball.vx; s->vy[i] = ball.vy;
+        s->active[i] = ball.active;
+        s->slotIndex[i] = ball.slotIndex;
+    }
+    return landed;
+}
+#endif
+
+#ifdef BALLSTORE_X86
+
+// Depois da parte vetorial: pega o desvio das bolas que bateram e
+// contabiliza as que aterrissaram. Os dois casos são raros por passo,
+// então ficam no escalar. Os desvios vêm de um lote sorteado de uma vez
+// com galtonFillJitter(), na mesma ordem em que galtonJitter() os daria.
+static void fillJitter(BallStore *s, float *jitter, int hitMask, int lanes, Rng *rng) {
+    for (int l = 0; l < lanes; l++) {
+        if (!(hitMask & (1 << l))) { jitter[l] = 0.0f; continue; }
+        if (s->jitterLeft == 0) {
+            galtonFillJitter(rng, s->jitter, BALLSTORE_JITTER_BATCH);
+            s->jitterLeft = BALLSTORE_JITTER_BATCH;
+        }
+        jitter[l] = s->jitter[BALLSTORE_JITTER_BATCH - s->jitterLeft--];
+    }
+}
+
+static int countLandings(BallStore *s, const GaltonBoard *board, int i, int landMask, int lanes, unsigned long long *slotCounts) {
+    int landed = 0;
+    for (int l = 0; l < lanes; l++) {
+        if (!(landMask & (1 << l))) continue;
+        s->slotIndex[i + l] = galtonSlotFromX(board, s->x[i + l]);
+        s->active[i + l] = 0;
+        if (slotCounts) slotCounts[s->slotIndex[i + l]]++;
+        landed++;
+    }
+    return landed;
+}
+
+// ----- Kernel SSE2: 4 bolas por vez -----
+static __m128 floorSse2(__m128 v) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, v), _mm_set1_ps(1.0f)));
+}
+
+static __m128 selectSse2(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static int stepSse2(BallStore *s, const GaltonBoard *board, float dt, Rng *rng, int begin, int end, unsigned long long *slotCounts) {
+    const float minDist = BALL_RADIUS + PIN_RADIUS;
+    const __m128 vDt      = _mm_set1_ps(dt);
+    const __m128 vGdt     = _mm_set1_ps(GRAVITY * dt);
+    const __m128 vHalf    = _mm_set1_ps(0.5f);
+    const __m128 vSpacing = _mm_set1_ps((float)PIN_SPACING);
+    const __m128 vInvSp   = _mm_set1_ps(1.0f / PIN_SPACING);
+    const __m128 vHalfSp  = _mm_set1_ps(PIN_SPACING / 2.0f);
+    const __m128 vZero    = _mm_setzero_ps();
+    const __m128 vMaxRow  = _mm_set1_ps((float)(board->numPinsY - 1));
+    const __m128 vMaxCol  = _mm_set1_ps((float)(board->numPinsX - 1));
+    const __m128 vPinY0   = _mm_set1_ps(board->firstPinY);
+    const __m128 vPinX0   = _mm_set1_ps(board->pinOriginX);
+    const __m128 vMin2    = _mm_set1_ps(minDist * minDist);
+    const __m128 vEps2    = _mm_set1_ps(0.0001f * 0.0001f);
+    const __m128 vMinDist = _mm_set1_ps(minDist);
+    const __m128 vRest    = _mm_set1_ps(BALL_RESTITUTION);
+    const __m128 vNegRest = _mm_set1_ps(-BALL_RESTITUTION);
+    const __m128 vTwo     = _mm_set1_ps(2.0f);
+    const __m128 vLeft    = _mm_set1_ps((float)BALL_RADIUS);
+    const __m128 vRight   = _mm_set1_ps(board->width - BALL_RADIUS);
+    const __m128 vFloor   = _mm_set1_ps(board->baseY - BALL_RADIUS);
+    int landed = 0;
+
+    for (int i = begin; i < end; i += 4) {
+        __m128 active = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_load_si128((const __m128i *)(s->active + i)), _mm_setzero_si128()));
+        int activeMask = _mm_movemask_ps(active);
+        if (activeMask == 0) continue;
+        s->pinTests += __builtin_popcount(activeMask);   // um pino (o mais próximo) por bola
+
+        __m128 x  = _mm_load_ps(s->x + i);
+        __m128 y  = _mm_load_ps(s->y + i);
+        __m128 vx = _mm_load_ps(s->vx + i);
+        __m128 vy = _mm_load_ps(s->vy + i);
+
+        // Integra a gravidade (só nas bolas ativas)
+        __m128 nvy = _mm_add_ps(vy, vGdt);
+        __m128 nx_ = _mm_add_ps(x, _mm_mul_ps(vx, vDt));
+        __m128 ny_ = _mm_add_ps(y, _mm_mul_ps(nvy, vDt));
+        vy = selectSse2(active, nvy, vy);
+        x  = selectSse2(active, nx_, x);
+        y  = selectSse2(active, ny_, y);
+
+        // Pino mais próximo: fileira pelo y, coluna pelo x
+        __m128 row = floorSse2(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(y, vPinY0), vInvSp), vHalf));
+        __m128 rowOk = _mm_and_ps(_mm_cmpge_ps(row, vZero), _mm_cmple_ps(row, vMaxRow));
+        __m128 parity = _mm_sub_ps(row, _mm_mul_ps(vTwo, floorSse2(_mm_mul_ps(row, vHalf))));
+        __m128 rowX = _mm_add_ps(vPinX0, _mm_mul_ps(parity, vHalfSp));
+        __m128 col = floorSse2(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, rowX), vInvSp), vHalf));
+        col = _mm_max_ps(vZero, _mm_min_ps(col, vMaxCol));
+        __m128 dx = _mm_sub_ps(x, _mm_add_ps(rowX, _mm_mul_ps(col, vSpacing)));
+        __m128 dy = _mm_sub_ps(y, _mm_add_ps(vPinY0, _mm_mul_ps(row, vSpacing)));
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 hit = _mm_and_ps(_mm_and_ps(active, rowOk),
+                                _mm_and_ps(_mm_cmplt_ps(d2, vMin2), _mm_cmpgt_ps(d2, vEps2)));
+        int hitMask = _mm_movemask_ps(hit);
+
+        if (hitMask) {
+            // Empurra para fora do pino e reflete com perda de energia
+            __m128 dist = _mm_sqrt_ps(_mm_max_ps(d2, vEps2));
+            __m128 nx = _mm_div_ps(dx, dist);
+            __m128 ny = _mm_div_ps(dy, dist);
+            __m128 pen = _mm_sub_ps(vMinDist, dist);
+            __m128 vDotN = _mm_add_ps(_mm_mul_ps(vx, nx), _mm_mul_ps(vy, ny));
+            __m128 rvx = _mm_mul_ps(_mm_sub_ps(vx, _mm_mul_ps(_mm_mul_ps(vTwo, vDotN), nx)), vRest);
+            __m128 rvy = _mm_mul_ps(_mm_sub_ps(vy, _mm_mul_ps(_mm_mul_ps(vTwo, vDotN), ny)), vRest);
+            float jitter[4];
+            fillJitter(s, jitter, hitMask, 4, rng);
+            rvx = _mm_add_ps(rvx, _mm_loadu_ps(jitter));
+            x  = selectSse2(hit, _mm_add_ps(x, _mm_mul_ps(nx, pen)), x);
+            y  = selectSse2(hit, _mm_add_ps(y, _mm_mul_ps(ny, pen)), y);
+            vx = selectSse2(hit, rvx, vx);
+            vy = selectSse2(hit, rvy, vy);
+        }
+
+        // Paredes laterais
+        __m128 hitLeft  = _mm_and_ps(active, _mm_cmplt_ps(x, vLeft));
+        x  = selectSse2(hitLeft, vLeft, x);
+        vx = selectSse2(hitLeft, _mm_mul_ps(vx, vNegRest), vx);
+        __m128 hitRight = _mm_and_ps(active, _mm_cmpgt_ps(x, vRight));
+        x  = selectSse2(hitRight, vRight, x);
+        vx = selectSse2(hitRight, _mm_mul_ps(vx, vNegRest), vx);
+
+        // Aterrissagem
+        __m128 land = _mm_and_ps(active, _mm_cmpgt_ps(y, vFloor));
+        y = selectSse2(land, vFloor, y);
+
+        _mm_store_ps(s->x + i, x);
+        _mm_store_ps(s->y + i, y);
+        _mm_store_ps(s->vx + i, vx);
+        _mm_store_ps(s->vy + i, vy);
+
+        int landMask = _mm_movemask_ps(land);
+        if (landMask) landed += countLandings(s, board, i, landMask, 4, slotCounts);
+    }
+    return landed;
+}
+
+// ----- Kernel AVX2: 8 bolas por vez (escolhido em tempo de execução) -----
+__attribute__((target("avx2")))
+static int stepAvx2(BallStore *s, const GaltonBoard *board, float dt, Rng *rng, int begin, int end, unsigned long long *slotCounts) {
+    const float minDist = BALL_RADIUS + PIN_RADIUS;
+    const __m256 vDt      = _mm256_set1_ps(dt);
+    const __m256 vGdt     = _mm256_set1_ps(GRAVITY * dt);
+    const __m256 vHalf    = _mm256_set1_ps(0.5f);
+    const __m256 vSpacing = _mm256_set1_ps((float)PIN_SPACING);
+    const __m256 vInvSp   = _mm256_set1_ps(1.0f / PIN_SPACING);
+    const __m256 vHalfSp  = _mm256_set1_ps(PIN_SPACING / 2.0f);
+    const __m256 vZero    = _mm256_setzero_ps();
+    const __m256 vMaxRow  = _mm256_set1_ps((float)(board->numPinsY - 1));
+    const __m256 vMaxCol  = _mm256_set1_ps((float)(board->numPinsX - 1));
+    const __m256 vPinY0   = _mm256_set1_ps(board->firstPinY);
+    const __m256 vPinX0   = _mm256_set1_ps(board->pinOriginX);
+    const __m256 vMin2    = _mm256_set1_ps(minDist * minDist);
+    const __m256 vEps2    = _mm256_set1_ps(0.0001f * 0.0001f);
+    const __m256 vMinDist = _mm256_set1_ps(minDist);
+    const __m256 vRest    = _mm256_set1_ps(BALL_RESTITUTION);
+    const __m256 vNegRest = _mm256_set1_ps(-BALL_RESTITUTION);
+    const __m256 vTwo     = _mm256_set1_ps(2.0f);
+    const __m256 vLeft    = _mm256_set1_ps((float)BALL_RADIUS);
+    const __m256 vRight   = _mm256_set1_ps(board->width - BALL_RADIUS);
+    const __m256 vFloor   = _mm256_set1_ps(board->baseY - BALL_RADIUS);
+    int landed = 0;
+
+    for (int i = begin; i < end; i += 8) {
+        __m256 active = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_load_si256((const __m256i *)(s->active + i)), _mm256_setzero_si256()));
+        int activeMask = _mm256_movemask_ps(active);
+        if (activeMask == 0) continue;
+        s->pinTests += __builtin_popcount(activeMask);   // um pino (o mais próximo) por bola
+
+        __m256 x  = _mm256_load_ps(s->x + i);
+        __m256 y  = _mm256_load_ps(s->y + i);
+        __m256 vx = _mm256_load_ps(s->vx + i);
+        __m256 vy = _mm256_load_ps(s->vy + i);
+
+        // Integra a gravidade (só nas bolas ativas)
+        __m256 nvy = _mm256_add_ps(vy, vGdt);
+        __m256 nx_ = _mm256_add_ps(x, _mm256_mul_ps(vx, vDt));
+        __m256 ny_ = _mm256_add_ps(y, _mm256_mul_ps(nvy, vDt));
+        vy = _mm256_blendv_ps(vy, nvy, active);
+        x  = _mm256_blendv_ps(x, nx_, active);
+        y  = _mm256_blendv_ps(y, ny_, active);
+
+        // Pino mais próximo: fileira pelo y, coluna pelo x
+        __m256 row = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(y, vPinY0), vInvSp), vHalf));
+        __m256 rowOk = _mm256_and_ps(_mm256_cmp_ps(row, vZero, _CMP_GE_OQ), _mm256_cmp_ps(row, vMaxRow, _CMP_LE_OQ));
+        __m256 parity = _mm256_sub_ps(row, _mm256_mul_ps(vTwo, _mm256_floor_ps(_mm256_mul_ps(row, vHalf))));
+        __m256 rowX = _mm256_add_ps(vPinX0, _mm256_mul_ps(parity, vHalfSp));
+        __m256 col = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(x, rowX), vInvSp), vHalf));
+        col = _mm256_max_ps(vZero, _mm256_min_ps(col, vMaxCol));
+        __m256 dx = _mm256_sub_ps(x, _mm256_add_ps(rowX, _mm256_mul_ps(col, vSpacing)));
+        __m256 dy = _mm256_sub_ps(y, _mm256_add_ps(vPinY0, _mm256_mul_ps(row, vSpacing)));
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 hit = _mm256_and_ps(_mm256_and_ps(active, rowOk),
+                                   _mm256_and_ps(_mm256_cmp_ps(d2, vMin2, _CMP_LT_OQ), _mm256_cmp_ps(d2, vEps2, _CMP_GT_OQ)));
+        int hitMask = _mm256_movemask_ps(hit);
+
+        if (hitMask) {
+            // Empurra para fora do pino e reflete com perda de energia
+            __m256 dist = _mm256_sqrt_ps(_mm256_max_ps(d2, vEps2));
+            __m256 nx = _mm256_div_ps(dx, dist);
+            __m256 ny = _mm256_div_ps(dy, dist);
+            __m256 pen = _mm256_sub_ps(vMinDist, dist);
+            __m256 vDotN = _mm256_add_ps(_mm256_mul_ps(vx, nx), _mm256_mul_ps(vy, ny));
+            __m256 rvx = _mm256_mul_ps(_mm256_sub_ps(vx, _mm256_mul_ps(_mm256_mul_ps(vTwo, vDotN), nx)), vRest);
+            __m256 rvy = _mm256_mul_ps(_mm256_sub_ps(vy, _mm256_mul_ps(_mm256_mul_ps(vTwo, vDotN), ny)), vRest);
+            float jitter[8];
+            fillJitter(s, jitter, hitMask, 8, rng);
+            rvx = _mm256_add_ps(rvx, _mm256_loadu_ps(jitter));
+            x  = _mm256_blendv_ps(x, _mm256_add_ps(x, _mm256_mul_ps(nx, pen)), hit);
+            y  = _mm256_blendv_ps(y, _mm256_add_ps(y, _mm256_mul_ps(ny, pen)), hit);
+            vx = _mm256_blendv_ps(vx, rvx, hit);
+            vy = _mm256_blendv_ps(vy, rvy, hit);
+        }
+
+        // Paredes laterais
+        __m256 hitLeft  = _mm256_and_ps(active, _mm256_cmp_ps(x, vLeft, _CMP_LT_OQ));
+        x  = _mm256_blendv_ps(x, vLeft, hitLeft);
+        vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, vNegRest), hitLeft);
+        __m256 hitRight = _mm256_and_ps(active, _mm256_cmp_ps(x, vRight, _CMP_GT_OQ));
+        x  = _mm256_blendv_ps(x, vRight, hitRight);
+        vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, vNegRest), hitRight);
+
+        // Aterrissagem
+        __m256 land = _mm256_and_ps(active, _mm256_cmp_ps(y, vFloor, _CMP_GT_OQ));
+        y = _mm256_blendv_ps(y, vFloor, land);
+
+        _mm256_store_ps(s->x + i, x);
+        _mm256_store_ps(s->y + i, y);
+        _mm256_store_ps(s->vx + i, vx);
+        _mm256_store_ps(s->vy + i, vy);
+
+        int landMask = _mm256_movemask_ps(land);
+        if (landMask) landed += countLandings(s, board, i, landMask, 8, slotCounts);
+    }
+    return landed;
+}
+
+#endif // BALLSTORE_X86
+
+typedef int (*StepKernel)(BallStore *, const GaltonBoard *, float, Rng *, int, int, unsigned long long *);
+
+static StepKernel pickKernel(const char **name) {
+#ifdef BALLSTORE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { *name = "avx2"; return stepAvx2; }
+    *name = "sse2";
+    return stepSse2;
+#else
+    *name = "scalar";
+    return stepScalar;
+#endif
+}
+
+// Escolhido uma vez só: várias threads (Monte Carlo, rollout, chuva) chamam
+// ballStoreStep() ao mesmo tempo
+static pthread_once_t kernelOnce = PTHREAD_ONCE_INIT;
+static StepKernel kernel = NULL;
+static const char *kernelName = "scalar";
+
+static void initKernel(void) {
+    kernel = pickKernel(&kernelName);
+}
+
+const char *ballStoreKernelName(void) {
+    pthread_once(&kernelOnce, initKernel);
+    return kernelName;
+}
+
+int ballStoreStep(BallStore *store, const GaltonBoard *board, float dt, Rng *rng, unsigned long long *slotCounts) {
+    pthread_once(&kernelOnce, initKernel);
+    // Blocos inteiros: as posições de sobra estão inativas (ver ballStoreClear)
+    int end = (store->count + BALLSTORE_LANES - 1) / BALLSTORE_LANES * BALLSTORE_LANES;
+    return kernel(store, board, dt, rng, 0, end, slotCounts);
+}
+
+// Bolas que não aterrissaram em GALTON_MAX_STEPS passos (presas entre
+// parede e pino, por exemplo) contam onde estão, como em galtonDropBall()
+static int landStuck(BallStore *s, const GaltonBoard *board, unsigned long long *slotCounts) {
+    int landed = 0;
+    for (int i = 0; i < s->count; i++) {
+        if (!s->active[i]) continue;
+        s->active[i] = 0;
+        s->slotIndex[i] = galtonSlotFromX(board, s->x[i]);
+        if (slotCounts) slotCounts[s->slotIndex[i]]++;
+        landed++;
+    }
+    return landed;
+}
+
+void ballStoreDropBalls(const GaltonBoard *board, long long n, int lanes, float dt, Rng *rng, unsigned long long *slotCounts) {
+    BallStore store;
+    if (lanes > n) lanes = (int)n;
+    if (lanes < 1 || ballStoreInit(&store, lanes) != 0) {
+        galtonDropBalls(board, n, dt, rng, slotCounts);
+        return;
+    }
+
+    long long spawned = 0, done = 0;
+    int idle = 0;   // passos seguidos sem nenhuma aterrissagem
+    for (int i = 0; i < lanes; i++, spawned++) ballStoreSpawn(&store, board);
+
+    while (done < n) {
+        int landed = ballStoreStep(&store, board, dt, rng, slotCounts);
+        if (landed) idle = 0;
+        else if (++idle >= GALTON_MAX_STEPS) {
+            landed = landStuck(&store, board, slotCounts);
+            idle = 0;
+        }
+        if (!landed) continue;
+        done += landed;
+        // Reaproveita as posições de quem aterrissou enquanto faltar bola
+        for (int i = 0; i < store.count && spawned < n; i++) {
+            if (!store.active[i]) { spawnAt(&store, board, i); spawned++; }
+        }
+    }
+    ballStoreFree(&store);
+}
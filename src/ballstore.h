@@ -0,0 +1,59 @@
+#ifndef BALLSTORE_H
+#define BALLSTORE_H
+
+#include "galton.h"
+
+// Muitas bolas ao mesmo tempo, guardadas como "estrutura de vetores" (SoA):
+// cada campo do Ball num vetor alinhado separado, para que os kernels SIMD
+// integrem e testem 4 (SSE2) ou 8 (AVX2) bolas de uma vez.
+
+#define BALLSTORE_LANES 8       // capacidade é sempre múltipla disto
+#define BALLSTORE_ALIGN 32      // alinhamento de cada vetor (um registrador AVX)
+#define BALLSTORE_JITTER_BATCH 256 // desvios sorteados de uma vez
+
+typedef struct {
+    float *x, *y;
+    float *vx, *vy;
+    int   *active;
+    int   *slotIndex;
+    int    count;      // bolas em uso: índices 0..count-1
+    int    capacity;
+    float  jitter[BALLSTORE_JITTER_BATCH]; // desvios já sorteados, usados em ordem
+    int    jitterLeft;
+    long long pinTests;  // pinos testados pelos kernels desde ballStoreInit (não zera no Clear)
+} BallStore;
+
+// Retorna 0 em caso de sucesso, -1 se faltar memória.
+int  ballStoreInit(BallStore *store, int capacity);
+void ballStoreFree(BallStore *store);
+
+// Remove todas as bolas (mantém a memória).
+void ballStoreClear(BallStore *store);
+
+// Solta uma nova bola no ponto de lançamento. Retorna o índice ou -1 se cheio.
+int  ballStoreSpawn(BallStore *store, const GaltonBoard *board);
+
+// Acrescenta uma cópia de 'ball' (posição e velocidade quaisquer).
+// Retorna o índice ou -1 se cheio.
+int  ballStoreAdd(BallStore *store, const Ball *ball);
+
+// Sobrescreve a bola 'i' (0 <= i < capacity). Não mexe em count; quem
+// reaproveita posições (rain.c) controla quais estão em uso.
+void ballStoreSet(BallStore *store, int i, const Ball *ball);
+
+// Avança todas as bolas ativas 'dt' segundos, com a mesma física de
+// galtonStepBall(). Bolas que aterrissam ficam inativas com slotIndex
+// preenchido e, se slotCounts != NULL, são somadas nele.
+// Retorna quantas bolas aterrissaram neste passo.
+int  ballStoreStep(BallStore *store, const GaltonBoard *board, float dt, Rng *rng, unsigned long long *slotCounts);
+
+// Versão em lote de galtonDropBalls(): mantém 'lanes' bolas caindo juntas
+// até 'n' aterrissarem, somando o slot de cada uma em slotCounts. Se
+// nenhuma aterrissa em GALTON_MAX_STEPS passos, as que sobraram contam onde
+// estão (como em galtonDropBall()).
+void ballStoreDropBalls(const GaltonBoard *board, long long n, int lanes, float dt, Rng *rng, unsigned long long *slotCounts);
+
+// Nome do kernel escolhido em tempo de execução ("avx2", "sse2" ou "scalar").
+const char *ballStoreKernelName(void);
+
+#endif
@@ -0,0 +1,129 @@
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include "binomial.h"
+
+long long factorial(int n) {
+    if (n < 0) return 0;
+    if (n == 0) return 1;
+    long long f = 1;
+    for (int i = 2; i <= n; i++) f *= i;
+    return f;
+}
+
+long long combinations(int n, int k) {
+    if (k < 0 || k > n) return 0;
+    long long denom = factorial(k) * factorial(n - k);
+    if (denom == 0) return 0;
+    return factorial(n) / denom;
+}
+
+// ----- Motor da PMF -----
+
+double binomialNormalErrorBound(int n) {
+    // Medido: max |PMF - normal| * n^1.5 converge para 1/(2 sqrt(2 pi)) ~ 0.1995
+    return n > 0 ? 0.2 / (n * sqrt((double)n)) : 1.0;
+}
+
+BinomialMethod binomialPickMethod(int n, double tolerance) {
+    if (n <= BINOMIAL_EXACT_MAX_N) return BINOMIAL_EXACT;
+    if (binomialNormalErrorBound(n) <= tolerance) return BINOMIAL_NORMAL;
+    return BINOMIAL_LGAMMA;
+}
+
+// Linha n do triângulo de Pascal em inteiros (C(62, 31) ainda cabe em 64
+// bits) vezes 2^-n: exata até o arredondamento final.
+static void fillExact(int n, double *pmf) {
+    unsigned long long row[BINOMIAL_EXACT_MAX_N + 1];
+    row[0] = 1;
+    for (int i = 1; i <= n; i++) {
+        row[i] = 1;
+        for (int k = i - 1; k >= 1; k--) row[k] += row[k - 1];
+    }
+    double scale = ldexp(1.0, -n);
+    for (int k = 0; k <= n; k++) pmf[k] = row[k] * scale;
+}
+
+// Termos de k em diante (e os espelhados) abaixo do menor double normal:
+// zera direto em vez de seguir multiplicando números subnormais, que é
+// muito lento.
+static void zeroTails(int n, int k, double *pmf) {
+    for (; k <= n; k++) pmf[k] = pmf[n - k] = 0.0;
+}
+
+// Moda por lgamma e o resto pela razão P(k+1)/P(k) = (n-k)/(k+1): uma
+// multiplicação por termo em vez de exp/log. Como p = 1/2, só a metade de
+// cima é calculada e espelhada.
+static void fillLgamma(int n, double *pmf) {
+    int m = (n + 1) / 2;
+    double v = exp(lgamma(n + 1.0) - lgamma(m + 1.0) - lgamma(n - m + 1.0) - n * log(2.0));
+    int k = m;
+    for (; k <= n && v >= DBL_MIN; k++) {
+        pmf[k] = pmf[n - k] = v;
+        v *= (double)(n - k) / (k + 1);
+    }
+    zeroTails(n, k, pmf);
+}
+
+// Densidade normal com média n/2 e variância n/4 nos inteiros. A razão
+// entre termos vizinhos também é geométrica (r_{k+1} = r_k * e^(-1/s²)),
+// então só o primeiro termo usa exp.
+static void fillNormal(int n, double *pmf) {
+    const double var = n / 4.0;
+    int m = (n + 1) / 2;
+    double x = m - n / 2.0;
+    double v = exp(-x * x / (2.0 * var)) / sqrt(2.0 * 3.14159265358979323846 * var);
+    double r = exp(-(2.0 * x + 1.0) / (2.0 * var));
+    const double q = exp(-1.0 / var);
+    int k = m;
+    for (; k <= n && v >= DBL_MIN; k++) {
+        pmf[k] = pmf[n - k] = v;
+        v *= r;
+        r *= q;
+    }
+    zeroTails(n, k, pmf);
+}
+
+BinomialMethod binomialPmfFill(int n, double tolerance, double *pmf) {
+    BinomialMethod method = binomialPickMethod(n, tolerance);
+    switch (method) {
+        case BINOMIAL_EXACT:  fillExact(n, pmf); break;
+        case BINOMIAL_LGAMMA: fillLgamma(n, pmf); break;
+        case BINOMIAL_NORMAL: fillNormal(n, pmf); break;
+    }
+    return method;
+}
+
+// ----- Tabelas guardadas -----
+
+// Tabelas já calculadas, indexadas por n
+static double **pmfTables = NULL;
+static int      pmfTableCount = 0;
+
+static double *buildPmf(int n) {
+    double *pmf = malloc(sizeof(double) * (n + 1));
+    if (pmf) binomialPmfFill(n, BINOMIAL_TABLE_TOLERANCE, pmf);
+    return pmf;
+}
+
+const double *binomialPmf(int n) {
+    if (n < 0) return NULL;
+    if (n >= pmfTableCount) {
+        int count = pmfTableCount ? pmfTableCount : 32;
+        while (count <= n) count *= 2;
+        double **bigger = realloc(pmfTables, sizeof(double *) * count);
+        if (!bigger) return NULL;
+        for (int i = pmfTableCount; i < count; i++) bigger[i] = NULL;
+        pmfTables = bigger;
+        pmfTableCount = count;
+    }
+    if (!pmfTables[n]) pmfTables[n] = buildPmf(n);
+    return pmfTables[n];
+}
+
+void binomialFreeTables(void) {
+    for (int i = 0; i < pmfTableCount; i++) free(pmfTables[i]);
+    free(pmfTables);
+    pmfTables = NULL;
+    pmfTableCount = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef BINOMIAL_H
+#define BINOMIAL_H
+
+// Funções de "Matemática" usadas nas barras teóricas (distribuição binomial).
+
+// Exatas só até n = 20: factorial(21) já não cabe em long long.
+long long factorial(int n);
+long long combinations(int n, int k);
+
+// Métodos para a PMF da binomial(n, 1/2), do mais exato ao mais barato:
+//   EXACT:  linha do triângulo de Pascal em inteiros (n <= 62), exata;
+//   LGAMMA: moda por lgamma + razão entre termos vizinhos, erro relativo
+//           da ordem de n log(n) * 1e-16;
+//   NORMAL: densidade normal N(n/2, n/4), erro absoluto por termo
+//           <= binomialNormalErrorBound(n) = 0.2 n^-1.5.
+// Todos são O(n) (EXACT é O(n²) mas só até 62) e só o primeiro termo usa
+// exp/lgamma; o resto é uma multiplicação por termo.
+typedef enum {
+    BINOMIAL_EXACT,
+    BINOMIAL_LGAMMA,
+    BINOMIAL_NORMAL
+} BinomialMethod;
+
+#define BINOMIAL_EXACT_MAX_N 62
+#define BINOMIAL_TABLE_TOLERANCE 1e-9   // erro absoluto aceito nas tabelas de binomialPmf()
+
+double binomialNormalErrorBound(int n);
+
+// Método mais barato cujo erro absoluto por termo fica abaixo de 'tolerance'.
+BinomialMethod binomialPickMethod(int n, double tolerance);
+
+// Preenche pmf[0..n] com o método escolhido e retorna qual foi.
+BinomialMethod binomialPmfFill(int n, double tolerance, double *pmf);
+
+// PMF da binomial(n, 1/2): n + 1 valores, P(k caminhos para a direita).
+// Calculada na primeira chamada para cada n (binomialPmfFill com
+// BINOMIAL_TABLE_TOLERANCE) e guardada, então depois é só uma consulta
+// (serve para milhares de fileiras).
+// Retorna NULL se faltar memória. O ponteiro vale até binomialFreeTables().
+const double *binomialPmf(int n);
+
+// Libera todas as tabelas guardadas.
+void binomialFreeTables(void);
+
+#endif
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <string.h>
+#include "boardlayers.h"
+
+#define BOARD_BACKGROUND (Color){5, 15, 40, 255}
+#define PANEL_BACKGROUND (Color){10, 20, 50, 255}
+
+static void unloadTarget(RenderTexture2D *target) {
+    if (target->id != 0) UnloadRenderTexture(*target);
+    target->id = 0;
+}
+
+static void releaseTargets(BoardLayers *layers) {
+    unloadTarget(&layers->board);
+    unloadTarget(&layers->panel);
+}
+
+// Cria as duas texturas para o tamanho pedido. Só troca as de 'layers'
+// (e o tamanho guardado) se as duas foram criadas; senão nada muda.
+static int createTargets(BoardLayers *layers, int width, int height, int gameAreaHeight) {
+    if (width <= 0 || gameAreaHeight <= 0 || height <= gameAreaHeight) return -1;
+    RenderTexture2D board = LoadRenderTexture(width, gameAreaHeight);
+    RenderTexture2D panel = LoadRenderTexture(width, height - gameAreaHeight);
+    if (board.id == 0 || panel.id == 0) {
+        unloadTarget(&board);
+        unloadTarget(&panel);
+        return -1;
+    }
+    releaseTargets(layers);
+    layers->board = board;
+    layers->panel = panel;
+    layers->width = width;
+    layers->height = height;
+    layers->gameAreaHeight = gameAreaHeight;
+    layers->boardValid = 0;
+    layers->panelValid = 0;
+    return 0;
+}
+
+int boardLayersInit(BoardLayers *layers, int width, int height, int gameAreaHeight) {
+    memset(layers, 0, sizeof(*layers));
+    return createTargets(layers, width, height, gameAreaHeight);
+}
+
+void boardLayersFree(BoardLayers *layers) {
+    releaseTargets(layers);
+}
+
+static int sameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static void renderBoard(BoardLayers *layers, const GaltonBoard *board, const int *slotValues, Color slotColor) {
+    BeginTextureMode(layers->board);
+    ClearBackground(BOARD_BACKGROUND);
+    for (int i = 0; i < board->pinCount; i++)
+        DrawCircle((int)board->pins[i].x, (int)board->pins[i].y, PIN_RADIUS, RAYWHITE);
+
+    DrawRectangle(0, board->baseY, layers->width, layers->gameAreaHeight - board->baseY, DARKGRAY);
+    for (int i = 0; i < board->slotCount; i++) {
+        float x = board->firstSlotX + i * board->slotWidth;
+        DrawLine(x, board->baseY, x, layers->gameAreaHeight, RAYWHITE);
+        char txt[16];
+        sprintf(txt, "%d", slotValues[i]);
+        DrawText(txt, x + board->slotWidth/2 - 20, board->baseY + 15, 16, slotColor);
+    }
+    EndTextureMode();
+    layers->slotColor = slotColor;
+    layers->boardValid = 1;
+}
+
+// Coordenadas relativas ao topo do painel (y = gameAreaHeight na tela)
+static void renderPanel(BoardLayers *layers) {
+    BeginTextureMode(layers->panel);
+    ClearBackground(PANEL_BACKGROUND);
+    DrawLine(0, 0, layers->width, 0, RAYWHITE);
+    DrawText("DISTRIBUIÇÃO DE PROBABILIDADE (EM TEMPO REAL)", 110, 15, 20, YELLOW);
+    EndTextureMode();
+    layers->panelValid = 1;
+}
+
+void boardLayersUpdate(BoardLayers *layers, const GaltonBoard *board, const int *slotValues,
+                       Color slotColor, int width, int height) {
+    if (width != layers->width || height != layers->height) {
+        createTargets(layers, width, height, layers->gameAreaHeight);
+    }
+    // Sem textura (id 0) o BeginTextureMode desenharia direto na tela
+    if (layers->board.id != 0 && (!layers->boardValid || !sameColor(slotColor, layers->slotColor)))
+        renderBoard(layers, board, slotValues, slotColor);
+    if (layers->panel.id != 0 && !layers->panelValid) renderPanel(layers);
+}
+
+void boardLayersDraw(const BoardLayers *layers) {
+    // As texturas de render ficam de cabeça para baixo no OpenGL: altura
+    // negativa no retângulo de origem desvira
+    if (layers->boardValid) {
+        Rectangle src = { 0, 0, (float)layers->board.texture.width, -(float)layers->board.texture.height };
+        DrawTextureRec(layers->board.texture, src, (Vector2){ 0, 0 }, WHITE);
+    }
+    if (layers->panelValid) {
+        Rectangle src = { 0, 0, (float)layers->panel.texture.width, -(float)layers->panel.texture.height };
+        DrawTextureRec(layers->panel.texture, src, (Vector2){ 0, (float)layers->gameAreaHeight }, WHITE);
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef BOARDLAYERS_H
+#define BOARDLAYERS_H
+
+#include "raylib.h"
+#include "galton.h"
+
+// Partes estáticas da tela desenhadas uma vez em texturas (RenderTexture)
+// e coladas a cada frame como um único retângulo cada:
+//  - tabuleiro: fundo, pinos, base, divisórias e valores dos slots;
+//  - painel: fundo, linha e título da área de estatística.
+// O tabuleiro só é redesenhado quando a cor dos valores ou o tamanho muda,
+// então o custo do frame não cresce com o número de pinos.
+
+typedef struct {
+    RenderTexture2D board;
+    RenderTexture2D panel;
+    int   width, height;      // tamanho da tela quando as texturas foram criadas
+    int   gameAreaHeight;     // altura do jogo (fixa, como no main.c); o painel fica com o resto
+    Color slotColor;          // cor usada no último desenho dos valores
+    int   boardValid;
+    int   panelValid;
+} BoardLayers;
+
+// Cria as texturas. Precisa da janela aberta (InitWindow).
+// Retorna 0 em caso de sucesso, -1 se não conseguiu criar as texturas.
+int  boardLayersInit(BoardLayers *layers, int width, int height, int gameAreaHeight);
+void boardLayersFree(BoardLayers *layers);
+
+// Redesenha o que estiver desatualizado (cor dos slots ou tamanho da tela
+// mudou). Deve ser chamada fora de BeginDrawing()/EndDrawing().
+// Num novo tamanho o jogo mantém a sua altura e só o painel muda; se as
+// texturas novas não forem criadas, ficam as antigas (e o tamanho antigo) e
+// a troca é tentada de novo no próximo frame.
+void boardLayersUpdate(BoardLayers *layers, const GaltonBoard *board, const int *slotValues,
+                       Color slotColor, int width, int height);
+
+// Cola as duas camadas (dentro de BeginDrawing()).
+void boardLayersDraw(const BoardLayers *layers);
+
+#endif
@@ -0,0 +1,564 @@
+#include <math.h>
+#include <stdlib.h>
+#include "galton.h"
+
+int galtonInitBoard(GaltonBoard *board, int numPinsX, int numPinsY, float width) {
+    board->numPinsX  = numPinsX;
+    board->numPinsY  = numPinsY;
+    board->slotCount = numPinsX + 1;
+    board->width     = width;
+    board->firstPinY = 100.0f;
+    board->baseY     = board->firstPinY + numPinsY * PIN_SPACING;
+    board->slotWidth = PIN_SPACING;
+    // Calcula o ponto inicial X para que os slots fiquem centralizados
+    board->firstSlotX = (width - board->slotCount * board->slotWidth) / 2.0f;
+
+    board->pinOriginX = width / 2.0f - numPinsX * PIN_SPACING / 2;
+
+    board->pinCount = 0;
+    board->pins = malloc(sizeof(Pin) * numPinsX * numPinsY);
+    if (!board->pins) return -1;
+
+    // Fileiras ímpares deslocadas meio espaçamento (tabuleiro "em zigue-zague")
+    for (int y = 0; y < numPinsY; y++) {
+        for (int x = 0; x < numPinsX; x++) {
+            float offset = (y % 2 == 0) ? 0 : PIN_SPACING / 2.0f;
+            board->pins[board->pinCount].x = width / 2.0f - numPinsX * PIN_SPACING / 2 + offset + x * PIN_SPACING;
+            board->pins[board->pinCount].y = board->firstPinY + y * PIN_SPACING;
+            board->pinCount++;
+        }
+    }
+    return 0;
+}
+
+void galtonFreeBoard(GaltonBoard *board) {
+    free(board->pins);
+    board->pins = NULL;
+    board->pinCount = 0;
+}
+
+void galtonSpawnBall(const GaltonBoard *board, Ball *ball) {
+    ball->x = board->width / 2.0f;
+    ball->y = board->firstPinY - PIN_SPACING;
+    ball->vx = 0;
+    ball->vy = 0;
+    ball->active = 1;
+    ball->slotIndex = -1;
+}
+
+// Fileiras de pinos que podem tocar uma bola na altura y
+static inline void candidateRows(const GaltonBoard *board, float y, int *rowMin, int *rowMax) {
+    const float minDist = BALL_RADIUS + PIN_RADIUS;
+    *rowMin = (int)ceilf((y - minDist - board->firstPinY) / PIN_SPACING);
+    *rowMax = (int)floorf((y + minDist - board->firstPinY) / PIN_SPACING);
+    if (*rowMin < 0) *rowMin = 0;
+    if (*rowMax > board->numPinsY - 1) *rowMax = board->numPinsY - 1;
+}
+
+// Colunas da fileira 'row' que podem tocar uma bola em x; rowX recebe o x
+// do primeiro pino da fileira
+static inline void candidateCols(const GaltonBoard *board, int row, float x, int *colMin, int *colMax, float *rowX) {
+    const float minDist = BALL_RADIUS + PIN_RADIUS;
+    *rowX = board->pinOriginX + ((row % 2 == 0) ? 0 : PIN_SPACING / 2.0f);
+    *colMin = (int)ceilf((x - minDist - *rowX) / PIN_SPACING);
+    *colMax = (int)floorf((x + minDist - *rowX) / PIN_SPACING);
+    if (*colMin < 0) *colMin = 0;
+    if (*colMax > board->numPinsX - 1) *colMax = board->numPinsX - 1;
+}
+
+// Primeiro pino encostado na bola: empurra para fora e reflete a velocidade.
+// Os pinos formam uma grade regular, então em vez de varrer todos eles
+// calculamos direto as fileiras e colunas que podem tocar a bola (no máximo
+// uma ou duas de cada com o espaçamento atual). A ordem de teste é a mesma
+// da varredura completa, logo o pino escolhido também é o mesmo.
+static int resolvePins(const GaltonBoard *board, Ball *ball) {
+    const float minDist = BALL_RADIUS + PIN_RADIUS;
+    int rowMin, rowMax;
+    candidateRows(board, ball->y, &rowMin, &rowMax);
+
+    for (int row = rowMin; row <= rowMax; row++) {
+        float rowX;
+        int colMin, colMax;
+        candidateCols(board, row, ball->x, &colMin, &colMax, &rowX);
+        float pinY = board->firstPinY + row * PIN_SPACING;
+
+        for (int col = colMin; col <= colMax; col++) {
+            float dx = ball->x - (rowX + col * PIN_SPACING);
+            float dy = ball->y - pinY;
+            float dist = sqrtf(dx*dx + dy*dy);
+            if (dist < minDist && dist > 0.0001f) {
+                float nx = dx / dist;
+                float ny = dy / dist;
+                float pen = minDist - dist;
+                ball->x += nx * pen;
+                ball->y += ny * pen;
+                float vDotN = ball->vx * nx + ball->vy * ny;
+                ball->vx = ball->vx - 2.0f * vDotN * nx;
+                ball->vy = ball->vy - 2.0f * vDotN * ny;
+                ball->vx *= BALL_RESTITUTION;
+                ball->vy *= BALL_RESTITUTION;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int galtonPinTests(const GaltonBoard *board, const Ball *ball) {
+    int rowMin, rowMax, tests = 0;
+    candidateRows(board, ball->y, &rowMin, &rowMax);
+    for (int row = rowMin; row <= rowMax; row++) {
+        float rowX;
+        int colMin, colMax;
+        candidateCols(board, row, ball->x, &colMin, &colMax, &rowX);
+        if (colMax >= colMin) tests += colMax - colMin + 1;
+    }
+    return tests;
+}
+
+void galtonClockInit(GaltonClock *clock, float step, int maxSubsteps) {
+    clock->step = step;
+    clock->maxSubsteps = maxSubsteps;
+    clock->accumulator = 0.0f;
+}
+
+void galtonClockReset(GaltonClock *clock) {
+    clock->accumulator = 0.0f;
+}
+
+int galtonClockAdvance(GaltonClock *clock, float frameTime) {
+    if (frameTime > 0.0f) clock->accumulator += frameTime;
+    int steps = (int)(clock->accumulator / clock->step);
+    if (steps > clock->maxSubsteps) {
+        // Frame travado (janela arrastada, chamada bloqueante...): roda o
+        // máximo permitido e joga fora o atraso em vez de acumular.
+        steps = clock->maxSubsteps;
+        clock->accumulator = fmodf(clock->accumulator, clock->step);
+        return steps;
+    }
+    clock->accumulator -= steps * clock->step;
+    return steps;
+}
+
+float galtonClockAlpha(const GaltonClock *clock) {
+    float alpha = clock->accumulator / clock->step;
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+    return alpha;
+}
+
+int galtonSlotFromX(const GaltonBoard *board, float x) {
+    int idx = (int)((x - board->firstSlotX) / board->slotWidth);
+    if (idx < 0) idx = 0;
+    if (idx >= board->slotCount) idx = board->slotCount - 1;
+    return idx;
+}
+
+// 200 valores igualmente prováveis entre -BALL_JITTER e +BALL_JITTER
+#define JITTER_LEVELS 200
+
+float galtonJitter(Rng *rng) {
+    return ((int)rngBounded(rng, JITTER_LEVELS) - JITTER_LEVELS / 2) / (JITTER_LEVELS / 2.0f) * BALL_JITTER;
+}
+
+void galtonFillJitter(Rng *rng, float *out, int n) {
+    uint32_t levels[64];
+    while (n > 0) {
+        int chunk = n < 64 ? n : 64;
+        rngFillBounded(rng, levels, chunk, JITTER_LEVELS);
+        for (int i = 0; i < chunk; i++) {
+            out[i] = ((int)levels[i] - JITTER_LEVELS / 2) / (JITTER_LEVELS / 2.0f) * BALL_JITTER;
+        }
+        out += chunk;
+        n -= chunk;
+    }
+}
+
+int galtonIntegrate(const GaltonBoard *board, Ball *ball, float dt) {
+    ball->vy += GRAVITY * dt;
+    ball->x += ball->vx * dt;
+    ball->y += ball->vy * dt;
+    return resolvePins(board, ball);
+}
+
+int galtonSettle(const GaltonBoard *board, Ball *ball) {
+    if (ball->x < BALL_RADIUS) { ball->x = BALL_RADIUS; ball->vx *= -BALL_RESTITUTION; }
+    if (ball->x > board->width - BALL_RADIUS) { ball->x = board->width - BALL_RADIUS; ball->vx *= -BALL_RESTITUTION; }
+
+    // Bola Aterrissou!
+    if (ball->y > board->baseY - BALL_RADIUS) {
+        ball->y = board->baseY - BALL_RADIUS;
+        ball->slotIndex = galtonSlotFromX(board, ball->x);
+        ball->active = 0;
+        return 1;
+    }
+    return 0;
+}
+
+int galtonStepBall(const GaltonBoard *board, Ball *ball, float dt, Rng *rng) {
+    if (!ball->active) return 0;
+    if (galtonIntegrate(board, ball, dt)) {
+        ball->vx += galtonJitter(rng);
+    }
+    return galtonSettle(board, ball);
+}
+
+int galtonDropBall(const GaltonBoard *board, float dt, Rng *rng) {
+    Ball ball;
+    galtonSpawnBall(board, &ball);
+    for (int step = 0; step < GALTON_MAX_STEPS; step++) {
+        if (galtonStepBall(board, &ball, dt, rng)) return ball.slotIndex;
+    }
+    // Nunca deveria acontecer; conta onde a bola está
+    return galtonSlotFromX(board, ball.x);
+}
+
+void galtonDropBalls(const GaltonBoard *board, long long n, float dt, Rng *rng, unsigned long long *slotCounts) {
+    for (long long i = 0; i < n; i++) {
+        slotCounts[galtonDropBall(board, dt, rng)]++;
+    }
+}
+
+// ----- Passo com colisão contínua -----
+// Dentro do passo a bola anda em linha reta (a gravidade já entrou na
+// velocidade, como em galtonIntegrate), então o instante de contato com um
+// pino é a menor raiz de |p + v t - pino|² = R² e o da parede é linear.
+// A bola anda até o primeiro contato, reflete e segue com o tempo que
+// sobrou, em vez de testar só a sobreposição no fim do passo.
+
+#define SWEPT_MAX_HITS 8   // contatos resolvidos por passo no máximo
+
+// Instante do primeiro contato com o pino (px, py) em [0, tMax], ou -1.
+static float sweptPinTime(const Ball *ball, float px, float py, float tMax) {
+    const float R = BALL_RADIUS + PIN_RADIUS;
+    float dx = ball->x - px, dy = ball->y - py;
+    float b = dx * ball->vx + dy * ball->vy;   // metade do termo linear
+    float c = dx * dx + dy * dy - R * R;
+    if (b >= 0.0f) return -1.0f;               // parada ou se afastando do pino
+    if (c <= 0.0f) return 0.0f;                // já encostada e entrando
+    float a = ball->vx * ball->vx + ball->vy * ball->vy;
+    float disc = b * b - a * c;
+    if (disc < 0.0f) return -1.0f;
+    float t = c / (-b + sqrtf(disc));          // forma estável da raiz menor
+    return t <= tMax ? t : -1.0f;
+}
+
+int galtonStepBallSwept(const GaltonBoard *board, Ball *ball, float dt, Rng *rng) {
+    if (!ball->active) return 0;
+    const float R = BALL_RADIUS + PIN_RADIUS;
+    ball->vy += GRAVITY * dt;
+
+    float left = dt;
+    for (int hit = 0; hit < SWEPT_MAX_HITS && left > 0.0f; hit++) {
+        // Pinos que o segmento deste passo pode tocar
+        float x1 = ball->x + ball->vx * left, y1 = ball->y + ball->vy * left;
+        int rowMin = (int)ceilf(((ball->y < y1 ? ball->y : y1) - R - board->firstPinY) / PIN_SPACING);
+        int rowMax = (int)floorf(((ball->y < y1 ? y1 : ball->y) + R - board->firstPinY) / PIN_SPACING);
+        if (rowMin < 0) rowMin = 0;
+        if (rowMax > board->numPinsY - 1) rowMax = board->numPinsY - 1;
+
+        float tHit = -1.0f, hitX = 0.0f, hitY = 0.0f;
+        for (int row = rowMin; row <= rowMax; row++) {
+            float rowX = board->pinOriginX + ((row % 2 == 0) ? 0 : PIN_SPACING / 2.0f);
+            float pinY = board->firstPinY + row * PIN_SPACING;
+            int colMin = (int)ceilf(((ball->x < x1 ? ball->x : x1) - R - rowX) / PIN_SPACING);
+            int colMax = (int)floorf(((ball->x < x1 ? x1 : ball->x) + R - rowX) / PIN_SPACING);
+            if (colMin < 0) colMin = 0;
+            if (colMax > board->numPinsX - 1) colMax = board->numPinsX - 1;
+            for (int col = colMin; col <= colMax; col++) {
+                float pinX = rowX + col * PIN_SPACING;
+                float t = sweptPinTime(ball, pinX, pinY, tHit >= 0.0f ? tHit : left);
+                if (t >= 0.0f && (tHit < 0.0f || t < tHit)) {
+                    tHit = t;
+                    hitX = pinX;
+                    hitY = pinY;
+                }
+            }
+        }
+
+        // Paredes
+        float tWall = -1.0f;
+        if (ball->vx < 0.0f && x1 < BALL_RADIUS) tWall = fmaxf((BALL_RADIUS - ball->x) / ball->vx, 0.0f);
+        if (ball->vx > 0.0f && x1 > board->width - BALL_RADIUS) tWall = fmaxf((board->width - BALL_RADIUS - ball->x) / ball->vx, 0.0f);
+
+        if (tHit < 0.0f && tWall < 0.0f) {
+            ball->x = x1;
+            ball->y = y1;
+            break;
+        }
+        if (tHit >= 0.0f && (tWall < 0.0f || tHit <= tWall)) {
+            ball->x += ball->vx * tHit;
+            ball->y += ball->vy * tHit;
+            float nx = (ball->x - hitX) / R, ny = (ball->y - hitY) / R;
+            float vDotN = ball->vx * nx + ball->vy * ny;
+            ball->vx = (ball->vx - 2.0f * vDotN * nx) * BALL_RESTITUTION + galtonJitter(rng);
+            ball->vy = (ball->vy - 2.0f * vDotN * ny) * BALL_RESTITUTION;
+            left -= tHit;
+        } else {
+            ball->x = ball->vx < 0.0f ? BALL_RADIUS : board->width - BALL_RADIUS;
+            ball->y += ball->vy * tWall;
+            ball->vx *= -BALL_RESTITUTION;
+            left -= tWall;
+        }
+    }
+    // Paredes já tratadas acima; aqui só a aterrissagem
+    return galtonSettle(board, ball);
+}
+
+int galtonDropBallSwept(const GaltonBoard *board, float dt, Rng *rng) {
+    Ball ball;
+    galtonSpawnBall(board, &ball);
+    for (int step = 0; step < GALTON_MAX_STEPS; step++) {
+        if (galtonStepBallSwept(board, &ball, dt, rng)) return ball.slotIndex;
+    }
+    return galtonSlotFromX(board, ball.x);
+}
+
+void galtonDropBallsSwept(const GaltonBoard *board, long long n, float dt, Rng *rng, unsigned long long *slotCounts) {
+    for (long long i = 0; i < n; i++) {
+        slotCounts[galtonDropBallSwept(board, dt, rng)]++;
+    }
+}
+
+// ----- Modo por eventos -----
+// Entre duas batidas a bola segue uma parábola exata:
+//   x(t) = x + vx t,  y(t) = y + vy t + (GRAVITY/2) t²
+// A batida num pino é a primeira raiz de |p(t) - pino|² - R² (um polinômio
+// de grau 4 em t), e paredes e base são equações de grau 1 e 2.
+
+#define EVENT_MIN_TIME 1e-9      // ignora "batidas" no instante atual
+#define EVENT_ROOT_STEPS 60
+
+static double polyEval(const double *c, int deg, double t) {
+    double v = c[deg];
+    for (int i = deg - 1; i >= 0; i--) v = v * t + c[i];
+    return v;
+}
+
+// Raízes de c[0] + c[1] t + ... + c[deg] t^deg em [a, b], em ordem (só a
+// primeira se 'firstOnly'). As raízes da derivada dividem [a, b] em pedaços
+// monótonos, e cada pedaço com troca de sinal tem exatamente uma raiz, achada
+// por Newton protegido por bissecção.
+static int polyRoots(const double *c, int deg, double a, double b, double *roots, int firstOnly) {
+    while (deg > 0 && c[deg] == 0.0) deg--;
+    if (deg == 0) return 0;
+    if (deg == 1) {
+        double t = -c[0] / c[1];
+        if (t < a || t > b) return 0;
+        roots[0] = t;
+        return 1;
+    }
+    if (deg == 2) {
+        double disc = c[1] * c[1] - 4.0 * c[2] * c[0];
+        if (disc < 0.0) return 0;
+        // Forma estável: evita subtrair números quase iguais
+        double q = -0.5 * (c[1] + (c[1] >= 0.0 ? sqrt(disc) : -sqrt(disc)));
+        double r0 = q / c[2];
+        double r1 = q != 0.0 ? c[0] / q : r0;
+        if (r0 > r1) { double tmp = r0; r0 = r1; r1 = tmp; }
+        int n = 0;
+        if (r0 >= a && r0 <= b) roots[n++] = r0;
+        if (r1 >= a && r1 <= b && r1 != r0 && !(firstOnly && n)) roots[n++] = r1;
+        return n;
+    }
+
+    double deriv[4] = { 0.0, 0.0, 0.0, 0.0 };
+    double cuts[4];
+    for (int i = 0; i < deg; i++) deriv[i] = (i + 1) * c[i + 1];
+    int nCuts = polyRoots(deriv, deg - 1, a, b, cuts, 0);
+
+    int n = 0;
+    double lo = a;
+    double fLo = polyEval(c, deg, lo);
+    if (fLo == 0.0) {
+        roots[n++] = lo;
+        if (firstOnly) return n;
+    }
+    for (int k = 0; k <= nCuts; k++) {
+        double hi = k < nCuts ? cuts[k] : b;
+        double fHi = polyEval(c, deg, hi);
+        if ((fLo < 0.0 && fHi > 0.0) || (fLo > 0.0 && fHi < 0.0)) {
+            double l = lo, r = hi, t = 0.5 * (lo + hi);
+            int lNeg = fLo < 0.0;
+            for (int it = 0; it < EVENT_ROOT_STEPS && r - l > 1e-12; it++) {
+                double f = polyEval(c, deg, t);
+                if (f == 0.0) break;
+                if ((f < 0.0) == lNeg) l = t; else r = t;
+                double d = polyEval(deriv, deg - 1, t);
+                double next = d != 0.0 ? t - f / d : l;
+                if (fabs(next - t) < 1e-12) { t = next; break; }
+                t = (next > l && next < r) ? next : 0.5 * (l + r);
+            }
+            roots[n++] = t;
+            if (firstOnly) return n;
+        } else if (fHi == 0.0 && hi > lo) {
+            roots[n++] = hi;
+            if (firstOnly) return n;
+        }
+        lo = hi;
+        fLo = fHi;
+    }
+    return n;
+}
+
+// Intervalos de [0, tEnd] em que y(t) fica entre lo e hi. A parábola é
+// convexa, então {y <= hi} é um intervalo e {y >= lo} é o complemento de
+// outro: sobram no máximo dois pedaços.
+static int bandSpans(double y, double vy, double lo, double hi, double tEnd, double spans[2][2]) {
+    const double h = GRAVITY / 2.0;
+    double inside[2], outside[2];
+    double c[3] = { y - hi, vy, h };
+    if (polyRoots(c, 2, -1e30, 1e30, inside, 0) < 2) return 0;
+    double a = inside[0] > 0.0 ? inside[0] : 0.0;
+    double b = inside[1] < tEnd ? inside[1] : tEnd;
+    if (a > b) return 0;
+
+    c[0] = y - lo;
+    if (polyRoots(c, 2, -1e30, 1e30, outside, 0) < 2) {
+        spans[0][0] = a; spans[0][1] = b;
+        return 1;
+    }
+    int n = 0;
+    if (a <= outside[0]) { spans[n][0] = a; spans[n][1] = outside[0] < b ? outside[0] : b; n++; }
+    if (b >= outside[1]) { spans[n][0] = outside[1] > a ? outside[1] : a; spans[n][1] = b; n++; }
+    return n;
+}
+
+// Primeiro instante em (t0, t1] em que a bola encosta no pino (px, py),
+// ou -1 se não encosta. Se ela já está encostada (acabou de bater nele),
+// o fator t é tirado do polinômio para achar a próxima batida.
+static double pinContactTime(double x, double y, double vx, double vy, double px, double py, double t0, double t1) {
+    const double h = GRAVITY / 2.0;
+    const double R = BALL_RADIUS + PIN_RADIUS;
+    double dx = x - px, dy = y - py;
+    double c[5];
+    c[0] = dx * dx + dy * dy - R * R;
+    c[1] = 2.0 * (dx * vx + dy * vy);
+    c[2] = vx * vx + vy * vy + 2.0 * dy * h;
+    c[3] = 2.0 * vy * h;
+    c[4] = h * h;
+
+    double roots[4];
+    int n;
+    if (t0 < EVENT_MIN_TIME) t0 = EVENT_MIN_TIME;
+    if (t0 > t1) return -1.0;
+    if (c[0] < 1e-3 * R) {
+        // Encostado. Se o desvio empurrou a bola para dentro do pino ela
+        // bate de novo na hora, como no passo fixo.
+        if (c[1] < 0.0) return t0;
+        n = polyRoots(c + 1, 3, t0, t1, roots, 1);
+    } else {
+        n = polyRoots(c, 4, t0, t1, roots, 1);
+    }
+    return n > 0 ? roots[0] : -1.0;
+}
+
+int galtonEventAdvance(const GaltonBoard *board, Ball *ball, float *elapsed) {
+    if (!ball->active) return GALTON_EVENT_LAND;
+    const double h = GRAVITY / 2.0;
+    const double R = BALL_RADIUS + PIN_RADIUS;
+    double x = ball->x, y = ball->y, vx = ball->vx, vy = ball->vy;
+
+    // Base e paredes
+    double yLand = board->baseY - BALL_RADIUS;
+    double tBase = y >= yLand ? 0.0 : (-vy + sqrt(vy * vy + 4.0 * h * (yLand - y))) / (2.0 * h);
+    double tWall = 1e30;
+    if (vx < 0.0) tWall = (BALL_RADIUS - x) / vx;
+    if (vx > 0.0) tWall = (board->width - BALL_RADIUS - x) / vx;
+    if (tWall < 0.0) tWall = 0.0;
+    double tEnd = tBase < tWall ? tBase : tWall;
+
+    // Fileiras que a parábola alcança até tEnd
+    double yMin = y, yMax = y + vy * tEnd + h * tEnd * tEnd;
+    if (yMax < yMin) { double tmp = yMin; yMin = yMax; yMax = tmp; }
+    double tTop = -vy / GRAVITY;
+    if (tTop > 0.0 && tTop < tEnd) {
+        double yTop = y + vy * tTop + h * tTop * tTop;
+        if (yTop < yMin) yMin = yTop;
+    }
+    int rowMin = (int)ceil((yMin - R - board->firstPinY) / PIN_SPACING);
+    int rowMax = (int)floor((yMax + R - board->firstPinY) / PIN_SPACING);
+    if (rowMin < 0) rowMin = 0;
+    if (rowMax > board->numPinsY - 1) rowMax = board->numPinsY - 1;
+
+    // Em cada fileira só os pinos sob o trecho em que a bola está na faixa
+    // de altura deles
+    double tPin = -1.0, hitX = 0.0, hitY = 0.0;
+    for (int row = rowMin; row <= rowMax; row++) {
+        double rowX = board->pinOriginX + ((row % 2 == 0) ? 0 : PIN_SPACING / 2.0);
+        double rowY = board->firstPinY + row * PIN_SPACING;
+        double spans[2][2];
+        int nSpans = bandSpans(y, vy, rowY - R, rowY + R, tPin >= 0.0 ? tPin : tEnd, spans);
+        for (int k = 0; k < nSpans; k++) {
+            double xa = x + vx * spans[k][0], xb = x + vx * spans[k][1];
+            double lo = (xa < xb ? xa : xb) - R, hi = (xa < xb ? xb : xa) + R;
+            int colMin = (int)ceil((lo - rowX) / PIN_SPACING);
+            int colMax = (int)floor((hi - rowX) / PIN_SPACING);
+            if (colMin < 0) colMin = 0;
+            if (colMax > board->numPinsX - 1) colMax = board->numPinsX - 1;
+            for (int col = colMin; col <= colMax; col++) {
+                double px = rowX + col * PIN_SPACING;
+                double t1 = tPin >= 0.0 ? tPin : spans[k][1];
+                double t = pinContactTime(x, y, vx, vy, px, rowY, spans[k][0], t1);
+                if (t >= 0.0 && (tPin < 0.0 || t < tPin)) {
+                    tPin = t;
+                    hitX = px;
+                    hitY = rowY;
+                }
+            }
+        }
+    }
+
+    double t = tPin >= 0.0 ? tPin : tEnd;
+    if (elapsed) *elapsed = (float)t;
+    x += vx * t;
+    y += vy * t + h * t * t;
+    vy += GRAVITY * t;
+
+    if (tPin >= 0.0) {
+        // Mesma resposta de resolvePins(), só que sem empurrar: a bola já
+        // está exatamente na distância mínima
+        double nx = (x - hitX) / R, ny = (y - hitY) / R;
+        double vDotN = vx * nx + vy * ny;
+        vx = (vx - 2.0 * vDotN * nx) * BALL_RESTITUTION;
+        vy = (vy - 2.0 * vDotN * ny) * BALL_RESTITUTION;
+        ball->x = (float)x; ball->y = (float)y;
+        ball->vx = (float)vx;
+        ball->vy = (float)vy;
+        return GALTON_EVENT_PIN;
+    }
+
+    ball->x = (float)x; ball->y = (float)y;
+    ball->vx = (float)vx; ball->vy = (float)vy;
+    if (tBase <= tWall) {
+        ball->y = board->baseY - BALL_RADIUS;
+        ball->slotIndex = galtonSlotFromX(board, ball->x);
+        ball->active = 0;
+        return GALTON_EVENT_LAND;
+    }
+    ball->x = vx < 0.0 ? BALL_RADIUS : board->width - BALL_RADIUS;
+    ball->vx = (float)(-vx * BALL_RESTITUTION);
+    return GALTON_EVENT_WALL;
+}
+
+int galtonEventStep(const GaltonBoard *board, Ball *ball, Rng *rng, float *elapsed) {
+    if (!ball->active) return 0;
+    int event = galtonEventAdvance(board, ball, elapsed);
+    if (event == GALTON_EVENT_PIN) ball->vx += galtonJitter(rng);
+    return event == GALTON_EVENT_LAND;
+}
+
+int galtonDropBallEvents(const GaltonBoard *board, Rng *rng) {
+    Ball ball;
+    galtonSpawnBall(board, &ball);
+    for (int event = 0; event < GALTON_MAX_STEPS; event++) {
+        if (galtonEventStep(board, &ball, rng, NULL)) return ball.slotIndex;
+    }
+    return galtonSlotFromX(board, ball.x);
+}
+
+void galtonDropBallsEvents(const GaltonBoard *board, long long n, Rng *rng, unsigned long long *slotCounts) {
+    for (long long i = 0; i < n; i++) {
+        slotCounts[galtonDropBallEvents(board, rng)]++;
+    }
+}
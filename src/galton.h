@@ -0,0 +1,139 @@
+#ifndef GALTON_H
+#define GALTON_H
+
+#include "rng.h"
+
+// Motor de simulação do tabuleiro de Galton, sem janela nem raylib.
+// O jogo (main.c) e as simulações em lote usam exatamente a mesma física.
+
+// Constantes físicas do tabuleiro
+#define PIN_SPACING 60
+#define PIN_RADIUS 5
+#define BALL_RADIUS 11
+#define GRAVITY 500.0f
+#define BALL_RESTITUTION 0.6f   // energia que sobra depois de bater num pino/parede
+#define BALL_JITTER 40.0f       // desvio horizontal aleatório máximo após bater num pino
+#define GALTON_HZ 240             // passo fixo da física, independente do FPS
+#define GALTON_DT (1.0f / GALTON_HZ)
+#define GALTON_MAX_SUBSTEPS 8     // passos por frame no máximo (o resto é descartado)
+#define GALTON_MAX_STEPS 100000 // trava de segurança para uma única queda
+
+// Structs
+typedef struct {
+    float x, y;
+    float vx, vy;
+    int   active;
+    int   slotIndex;
+} Ball;
+
+typedef struct {
+    float x, y;
+} Pin;
+
+// Acumulador do passo fixo: o tempo real de cada frame entra aqui e sai
+// em passos inteiros de 'step' segundos.
+typedef struct {
+    float accumulator;
+    float step;
+    int   maxSubsteps;
+} GaltonClock;
+
+typedef struct {
+    int   numPinsX, numPinsY;
+    int   slotCount;      // numPinsX + 1
+    float width;          // paredes em x = 0 e x = width
+    float firstPinY;      // y da primeira fileira de pinos
+    float baseY;          // altura em que a bola aterrissa nos slots
+    float slotWidth;
+    float firstSlotX;
+    float pinOriginX;     // x do primeiro pino das fileiras pares (ímpares: + PIN_SPACING/2)
+    Pin  *pins;           // fileira por fileira, numPinsX por fileira (usado no desenho)
+    int   pinCount;
+} GaltonBoard;
+
+// Monta o tabuleiro centralizado numa área de largura 'width'.
+// Retorna 0 em caso de sucesso, -1 se faltar memória.
+int  galtonInitBoard(GaltonBoard *board, int numPinsX, int numPinsY, float width);
+void galtonFreeBoard(GaltonBoard *board);
+
+// Coloca a bola parada no ponto de lançamento (centro, acima dos pinos).
+void galtonSpawnBall(const GaltonBoard *board, Ball *ball);
+
+// Avança a bola 'dt' segundos. Retorna 1 se ela aterrissou neste passo
+// (ball->slotIndex preenchido e ball->active zerado), 0 caso contrário.
+int  galtonStepBall(const GaltonBoard *board, Ball *ball, float dt, Rng *rng);
+
+void  galtonClockInit(GaltonClock *clock, float step, int maxSubsteps);
+void  galtonClockReset(GaltonClock *clock);
+
+// Soma o tempo do frame e retorna quantos passos fixos rodar agora.
+// Um frame muito longo roda no máximo maxSubsteps passos.
+int   galtonClockAdvance(GaltonClock *clock, float frameTime);
+
+// Fração de passo que sobrou no acumulador (0..1), para interpolar o desenho
+// entre o estado anterior e o atual.
+float galtonClockAlpha(const GaltonClock *clock);
+
+// Slot em que cai uma bola na posição horizontal x (limitado às bordas).
+int  galtonSlotFromX(const GaltonBoard *board, float x);
+
+// Quantos pinos o passo fixo testaria contra a bola na posição atual
+// (a janela de fileiras e colunas de galtonStepBall). Para contadores.
+int  galtonPinTests(const GaltonBoard *board, const Ball *ball);
+
+// Desvio horizontal aleatório aplicado depois de cada batida num pino.
+// Cada simulação (thread) passa o próprio gerador.
+float galtonJitter(Rng *rng);
+
+// Mesmos valores de galtonJitter(), 'n' de uma vez.
+void  galtonFillJitter(Rng *rng, float *out, int n);
+
+// As duas metades de galtonStepBall(), para quem quer escolher o desvio
+// (ex.: o solver em markov.c). galtonIntegrate() aplica a gravidade e a
+// batida no pino e retorna 1 se bateu; o desvio deve ser somado em vx
+// antes de galtonSettle(), que trata paredes e aterrissagem e retorna 1
+// se a bola aterrissou.
+int  galtonIntegrate(const GaltonBoard *board, Ball *ball, float dt);
+int  galtonSettle(const GaltonBoard *board, Ball *ball);
+
+// Solta uma bola e simula até ela aterrissar. Retorna o slot.
+int  galtonDropBall(const GaltonBoard *board, float dt, Rng *rng);
+
+// Solta 'n' bolas, uma de cada vez, somando o slot de cada uma em slotCounts
+// (board->slotCount posições; o vetor NÃO é zerado aqui).
+void galtonDropBalls(const GaltonBoard *board, long long n, float dt, Rng *rng, unsigned long long *slotCounts);
+
+// Passo com colisão contínua: acha o primeiro contato (pino ou parede)
+// dentro do passo, reflete ali e continua com o tempo que sobrou, com um
+// desvio por batida. Não deixa a bola atravessar pinos com v*dt grande,
+// então aceita passos bem maiores que GALTON_DT com o mesmo resultado.
+// Só o benchmark usa (drops_per_sec_swept_60hz): o jogo, os kernels do
+// BallStore, o Monte Carlo, o rollout e a chuva ficam no passo fixo de
+// GALTON_DT com colisão por sobreposição, para todos darem a mesma
+// distribuição da bola que o jogador vê.
+int  galtonStepBallSwept(const GaltonBoard *board, Ball *ball, float dt, Rng *rng);
+int  galtonDropBallSwept(const GaltonBoard *board, float dt, Rng *rng);
+void galtonDropBallsSwept(const GaltonBoard *board, long long n, float dt, Rng *rng, unsigned long long *slotCounts);
+
+// Modo por eventos, para simulações sem janela: em vez de passos fixos a
+// bola pula direto para o próximo evento (batida num pino, parede ou base),
+// resolvendo a parábola contra o círculo de raio BALL_RADIUS + PIN_RADIUS
+// de cada pino candidato. Uma queda custa uma chamada por batida.
+// É o limite contínuo da física de galtonStepBall() (sem a penetração de
+// até v*dt do passo fixo), então a distribuição difere um pouco da dele.
+
+// Avança a bola até o próximo evento e o aplica (reflexão + desvio no pino).
+// Retorna 1 se ela aterrissou; 'elapsed' (pode ser NULL) recebe o tempo
+// que passou.
+int  galtonEventStep(const GaltonBoard *board, Ball *ball, Rng *rng, float *elapsed);
+
+// galtonEventStep() sem o desvio (para quem escolhe o desvio, ex.: o solver
+// em markov.c). Retorna qual evento foi aplicado.
+#define GALTON_EVENT_PIN  0
+#define GALTON_EVENT_WALL 1
+#define GALTON_EVENT_LAND 2
+int  galtonEventAdvance(const GaltonBoard *board, Ball *ball, float *elapsed);
+int  galtonDropBallEvents(const GaltonBoard *board, Rng *rng);
+void galtonDropBallsEvents(const GaltonBoard *board, long long n, Rng *rng, unsigned long long *slotCounts);
+
+#endif
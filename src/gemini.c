@@ -4,14 +4,10 @@
 #include <curl/curl.h>
 #include "cJSON.h"
 #include "gemini.h"
+#include "trace.h"
 
-#define API_KEY "SUA_CHAVE_AQUI"
-#define MAX_RESPOSTA  1024
-
-typedef struct {
-    char *ptr;
-    size_t len;
-} StringBuf;
+#define API_KEY_PLACEHOLDER "SUA_CHAVE_AQUI"
+#define API_KEY API_KEY_PLACEHOLDER
 
 static void sbInit(StringBuf *s) {
     s->len = 0;
@@ -31,13 +27,22 @@ static size_t sbWrite(void *data, size_t size, size_t nmemb, void *userp) {
     return add;
 }
 
-void respt(const char *prompt, char *out) {
-    CURL *curl = curl_easy_init();
-    if (!curl) {
-        strncpy(out, "Erro ao iniciar libcurl.", MAX_RESPOSTA);
-        return;
-    }
+static const char *endpoint =
+    "https://generativelanguage.googleapis.com/"
+    "v1beta/models/gemini-1.5-flash-latest:generateContent?key=" API_KEY;
+
+static int customEndpoint = 0;
+
+void geminiSetEndpoint(const char *url) {
+    endpoint = url;
+    customEndpoint = 1;
+}
+
+int geminiConfigured(void) {
+    return customEndpoint || strcmp(API_KEY, API_KEY_PLACEHOLDER) != 0;
+}
 
+char *geminiBuildRequest(const char *prompt) {
     cJSON *root      = cJSON_CreateObject();
     cJSON *contents  = cJSON_AddArrayToObject(root, "contents");
     cJSON *mensagem  = cJSON_CreateObject();
@@ -51,75 +56,270 @@ void respt(const char *prompt, char *out) {
 
     char *jsonReq = cJSON_PrintUnformatted(root);
     cJSON_Delete(root);
+    return jsonReq;
+}
 
-    const char *url =
-        "https://generativelanguage.googleapis.com/"
-        "v1beta/models/gemini-1.5-flash-latest:generateContent?key=" API_KEY;
+int geminiParseResponse(const char *body, char *out) {
+    int ok = 0;
+    traceBegin("cJSON_Parse");
+    cJSON *rootResp = cJSON_Parse(body);
+    traceEnd("cJSON_Parse");
+    if (!rootResp) {
+        strncpy(out, "Falha ao parsear JSON de resposta.", MAX_RESPOSTA);
+        return 0;
+    }
 
-    struct curl_slist *hdrs = NULL;
-    hdrs = curl_slist_append(hdrs, "Content-Type: application/json; charset=utf-8");
+    cJSON *cands = cJSON_GetObjectItemCaseSensitive(rootResp, "candidates");
+    if (cJSON_IsArray(cands) && cJSON_GetArraySize(cands) > 0) {
+        cJSON *first      = cJSON_GetArrayItem(cands, 0);
+        cJSON *contentObj = cJSON_GetObjectItemCaseSensitive(first, "content");
+        cJSON *partsArr   = cJSON_GetObjectItemCaseSensitive(contentObj, "parts");
+        cJSON *firstPart  = (partsArr && cJSON_GetArraySize(partsArr) > 0)
+                            ? cJSON_GetArrayItem(partsArr, 0)
+                            : NULL;
+        cJSON *txt        = firstPart
+                            ? cJSON_GetObjectItemCaseSensitive(firstPart, "text")
+                            : NULL;
 
-    StringBuf resp;
-    sbInit(&resp);
+        if (cJSON_IsString(txt)) {
+            strncpy(out, txt->valuestring, MAX_RESPOSTA - 1);
+            out[MAX_RESPOSTA - 1] = '\0';
+            ok = 1;
+        } else {
+            strncpy(out, "Campo \"text\" ausente ou inválido.", MAX_RESPOSTA);
+        }
+    } else {
+        cJSON *err  = cJSON_GetObjectItemCaseSensitive(rootResp, "error");
+        cJSON *msg  = err ? cJSON_GetObjectItemCaseSensitive(err, "message") : NULL;
+        snprintf(out, MAX_RESPOSTA, "Erro da API: %s",
+                 (msg && cJSON_IsString(msg)) ? msg->valuestring : "desconhecido");
+    }
+    cJSON_Delete(rootResp);
+    return ok;
+}
 
-    curl_easy_setopt(curl, CURLOPT_URL,            url);
+// Opções fixas do handle, aplicadas uma vez: o handle guarda conexões e
+// DNS entre as requisições enquanto não for liberado
+static void setupHandle(CURL *curl, struct curl_slist *hdrs, StringBuf *resp) {
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER,     hdrs);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS,     jsonReq);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE,  (long)strlen(jsonReq));
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION,  sbWrite);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA,      &resp);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA,      resp);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    // HTTP/2 via ALPN quando é https (http puro continua em HTTP/1.1)
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,   (long)CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE,  1L);
+    // Sem isso uma conexão parada deixaria a requisição pendente para sempre
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, GEMINI_CONNECT_TIMEOUT);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT,        GEMINI_TIMEOUT);
+}
 
-    CURLcode cret = curl_easy_perform(curl);
+// Opções de cada requisição. 'jsonReq' não é copiado.
+static void setupRequest(CURL *curl, const char *jsonReq, StringBuf *resp) {
+    resp->len = 0;
+    resp->ptr[0] = '\0';
+    curl_easy_setopt(curl, CURLOPT_URL,            endpoint);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS,     jsonReq);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE,  (long)strlen(jsonReq));
+}
+
+// Resultado da transferência -> texto da resposta ou mensagem de erro.
+// Retorna 1 se achou o texto.
+static int finishResponse(CURL *curl, CURLcode cret, const char *body, char *out) {
     long httpCode = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-
-    free(jsonReq);
-
     if (cret != CURLE_OK) {
         snprintf(out, MAX_RESPOSTA, "Erro de rede: %s", curl_easy_strerror(cret));
+        return 0;
     }
-    else if (httpCode != 200) {
+    if (httpCode != 200) {
         snprintf(out, MAX_RESPOSTA, "HTTP %ld devolvido pela API.", httpCode);
+        return 0;
     }
-    else {
-        cJSON *rootResp = cJSON_Parse(resp.ptr);
-        if (!rootResp) {
-            strncpy(out, "Falha ao parsear JSON de resposta.", MAX_RESPOSTA);
-        }
-        else {
-            cJSON *cands = cJSON_GetObjectItemCaseSensitive(rootResp, "candidates");
-            if (cJSON_IsArray(cands) && cJSON_GetArraySize(cands) > 0) {
-                cJSON *first      = cJSON_GetArrayItem(cands, 0);
-                cJSON *contentObj = cJSON_GetObjectItemCaseSensitive(first, "content");
-                cJSON *partsArr   = cJSON_GetObjectItemCaseSensitive(contentObj, "parts");
-                cJSON *firstPart  = (partsArr && cJSON_GetArraySize(partsArr) > 0)
-                                    ? cJSON_GetArrayItem(partsArr, 0)
-                                    : NULL;
-                cJSON *txt        = firstPart
-                                    ? cJSON_GetObjectItemCaseSensitive(firstPart, "text")
-                                    : NULL;
-
-                if (cJSON_IsString(txt)) {
-                    printf("Resposta Gemini: %s\n", txt->valuestring);
-
-                    strncpy(out, txt->valuestring, MAX_RESPOSTA - 1);
-                    out[MAX_RESPOSTA - 1] = '\0';
-                } else {
-                    strncpy(out, "Campo \"text\" ausente ou inválido.", MAX_RESPOSTA);
-                }
-            } else {
-                cJSON *err  = cJSON_GetObjectItemCaseSensitive(rootResp, "error");
-                cJSON *msg  = err ? cJSON_GetObjectItemCaseSensitive(err, "message") : NULL;
-                snprintf(out, MAX_RESPOSTA, "Erro da API: %s",
-                         (msg && cJSON_IsString(msg)) ? msg->valuestring : "desconhecido");
-            }
-            cJSON_Delete(rootResp);
+    return geminiParseResponse(body, out);
+}
+
+static struct curl_slist *jsonHeaders(void) {
+    return curl_slist_append(NULL, "Content-Type: application/json; charset=utf-8");
+}
+
+// ----- Cliente persistente -----
+
+int geminiClientInit(GeminiClient *c) {
+    memset(c, 0, sizeof(*c));
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) return -1;
+    c->easy = curl_easy_init();
+    c->hdrs = jsonHeaders();
+    if (!c->easy || !c->hdrs) {
+        if (c->easy) curl_easy_cleanup(c->easy);
+        curl_slist_free_all(c->hdrs);
+        curl_global_cleanup();
+        return -1;
+    }
+    sbInit(&c->resp);
+    setupHandle(c->easy, c->hdrs, &c->resp);
+    return 0;
+}
+
+void geminiClientFree(GeminiClient *c) {
+    if (!c->easy) return;
+    curl_easy_cleanup(c->easy);
+    curl_slist_free_all(c->hdrs);
+    free(c->resp.ptr);
+    curl_global_cleanup();
+    memset(c, 0, sizeof(*c));
+}
+
+int geminiClientAsk(GeminiClient *c, const char *prompt, char *out) {
+    char *jsonReq = geminiBuildRequest(prompt);
+    if (!jsonReq) {
+        strncpy(out, "Falha ao montar JSON da requisição.", MAX_RESPOSTA);
+        return 0;
+    }
+    setupRequest(c->easy, jsonReq, &c->resp);
+
+    traceBegin("curl_easy_perform");
+    CURLcode cret = curl_easy_perform(c->easy);
+    traceEnd("curl_easy_perform");
+
+    long connects = 0;
+    curl_easy_getinfo(c->easy, CURLINFO_NUM_CONNECTS, &connects);
+    c->connects += connects;
+    c->requests++;
+
+    int ok = finishResponse(c->easy, cret, c->resp.ptr, out);
+    curl_easy_setopt(c->easy, CURLOPT_POSTFIELDS, NULL);
+    free(jsonReq);
+    return ok;
+}
+
+// respt() usa um cliente só para o programa inteiro
+static GeminiClient defaultClient;
+static int defaultClientOk;
+
+void respt(const char *prompt, char *out) {
+    traceBegin("respt");
+    if (!defaultClientOk) defaultClientOk = geminiClientInit(&defaultClient) == 0;
+    if (!defaultClientOk) {
+        strncpy(out, "Erro ao iniciar libcurl.", MAX_RESPOSTA);
+        traceEnd("respt");
+        return;
+    }
+    if (geminiClientAsk(&defaultClient, prompt, out)) {
+        printf("Resposta Gemini: %s\n", out);
+    }
+    traceEnd("respt");
+}
+
+void geminiCleanup(void) {
+    if (defaultClientOk) geminiClientFree(&defaultClient);
+    defaultClientOk = 0;
+}
+
+// ----- Requisições assíncronas -----
+
+int geminiAsyncInit(GeminiAsync *g) {
+    memset(g, 0, sizeof(*g));
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) return -1;
+    g->multi = curl_multi_init();
+    g->hdrs = jsonHeaders();
+    if (!g->multi || !g->hdrs) {
+        if (g->multi) curl_multi_cleanup(g->multi);
+        curl_slist_free_all(g->hdrs);
+        curl_global_cleanup();
+        return -1;
+    }
+    // Requisições simultâneas dividem uma conexão HTTP/2
+    curl_multi_setopt(g->multi, CURLMOPT_PIPELINING, (long)CURLPIPE_MULTIPLEX);
+    return 0;
+}
+
+// Tira a requisição do multi. O handle fica na posição para a próxima
+// (as conexões ficam no cache do multi)
+static void releaseRequest(GeminiAsync *g, GeminiRequest *r) {
+    curl_multi_remove_handle(g->multi, r->easy);
+    free(r->body);
+    r->body = NULL;
+    r->busy = 0;
+    r->callback = NULL;
+    r->user = NULL;
+    g->pending--;
+}
+
+void geminiAsyncFree(GeminiAsync *g) {
+    if (!g->multi) return;
+    for (int i = 0; i < GEMINI_MAX_PENDING; i++) {
+        GeminiRequest *r = &g->requests[i];
+        if (r->busy) releaseRequest(g, r);
+        if (r->easy) {
+            curl_easy_cleanup(r->easy);
+            free(r->resp.ptr);
         }
     }
+    curl_multi_cleanup(g->multi);
+    curl_slist_free_all(g->hdrs);
+    curl_global_cleanup();
+    memset(g, 0, sizeof(*g));
+}
+
+int geminiAsyncSubmit(GeminiAsync *g, const char *prompt, GeminiCallback callback, void *user) {
+    GeminiRequest *r = NULL;
+    for (int i = 0; i < GEMINI_MAX_PENDING && !r; i++) {
+        if (!g->requests[i].busy) r = &g->requests[i];
+    }
+    if (!r) return -1;
 
-    free(resp.ptr);
-    curl_slist_free_all(hdrs);
-    curl_easy_cleanup(curl);
+    if (!r->easy) {
+        r->easy = curl_easy_init();
+        if (!r->easy) return -1;
+        sbInit(&r->resp);
+        setupHandle(r->easy, g->hdrs, &r->resp);
+        // Espera a conexão HTTP/2 aberta em vez de abrir outra
+        curl_easy_setopt(r->easy, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(r->easy, CURLOPT_PRIVATE, r);
+    }
+    r->body = geminiBuildRequest(prompt);
+    if (!r->body) return -1;
+    setupRequest(r->easy, r->body, &r->resp);
+    if (curl_multi_add_handle(g->multi, r->easy) != CURLM_OK) {
+        free(r->body);
+        r->body = NULL;
+        return -1;
+    }
+
+    r->busy = 1;
+    r->id = ++g->nextId;
+    r->callback = callback;
+    r->user = user;
+    g->pending++;
+    return r->id;
+}
+
+int geminiAsyncPoll(GeminiAsync *g) {
+    if (g->pending == 0) return 0;
+
+    traceBegin("curl_multi_perform");
+    int running = 0;
+    curl_multi_perform(g->multi, &running);
+    traceEnd("curl_multi_perform");
+
+    CURLMsg *msg;
+    int left;
+    while ((msg = curl_multi_info_read(g->multi, &left)) != NULL) {
+        if (msg->msg != CURLMSG_DONE) continue;
+        GeminiRequest *r = NULL;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char **)&r);
+        if (!r) continue;
+
+        char out[MAX_RESPOSTA];
+        int ok = finishResponse(r->easy, msg->data.result, r->resp.ptr, out);
+        int id = r->id;
+        GeminiCallback callback = r->callback;
+        void *user = r->user;
+        // Libera antes do callback: ele pode enfileirar outra requisição
+        releaseRequest(g, r);
+        traceInstant("gemini respondeu");
+        if (callback) callback(id, ok, out, user);
+    }
+    return g->pending;
 }
@@ -1,6 +1,111 @@
 #ifndef GEMINI_H
 #define GEMINI_H
 
+#include <stddef.h>
+
+#define MAX_RESPOSTA  1024   // tamanho do buffer de resposta
+#define GEMINI_CONNECT_TIMEOUT 5L    // segundos para conectar (DNS, TCP e TLS)
+#define GEMINI_TIMEOUT         20L   // segundos para a requisição inteira
+
+// Pergunta bloqueante. Usa um GeminiClient interno, criado na primeira
+// chamada, então só ela paga DNS + TCP + TLS. Não é thread-safe.
 void respt(const char *prompt, char *respostaBuffer);
+// Libera o cliente de respt() (fim do programa).
+void geminiCleanup(void);
+
+// Partes de respt() usadas separadamente (benchmark, clientes assíncronos).
+
+// Troca a URL da API (ex.: um servidor local de teste). A string não é
+// copiada e precisa continuar válida.
+void  geminiSetEndpoint(const char *url);
+
+// 1 se há uma chave de API de verdade em gemini.c (ou um endpoint trocado
+// com geminiSetEndpoint); com a chave de exemplo toda requisição falha.
+int   geminiConfigured(void);
+
+// Corpo JSON da requisição para 'prompt'. Liberar com free().
+char *geminiBuildRequest(const char *prompt);
+
+// Extrai o texto da resposta (ou a mensagem de erro) para 'out'
+// (MAX_RESPOSTA bytes). Retorna 1 se achou o texto.
+int   geminiParseResponse(const char *body, char *out);
+
+// Corpo da resposta, crescendo conforme o curl recebe
+typedef struct {
+    char  *ptr;
+    size_t len;
+} StringBuf;
+
+// ----- Cliente persistente -----
+// Um handle do curl para a sessão inteira: cabeçalhos montados uma vez e o
+// cache de conexões e de DNS do handle mantido entre as chamadas, então a
+// conexão (HTTP/2 com TLS, via ALPN) é reaproveitada de uma pergunta para
+// a outra.
+// Os handles do curl ficam como void *: curl.h no Windows puxa windows.h,
+// que briga com o raylib em main.c.
+
+typedef struct {
+    void     *easy;       // CURL *
+    void     *hdrs;       // struct curl_slist *
+    StringBuf resp;
+    long      connects;   // conexões novas abertas até agora
+    long      requests;
+} GeminiClient;
+
+// Retorna 0 em caso de sucesso, -1 se o curl não iniciar.
+int  geminiClientInit(GeminiClient *c);
+void geminiClientFree(GeminiClient *c);
+
+// Como respt(), sem imprimir. Retorna 1 se 'out' tem o texto do modelo;
+// senão 'out' tem a mensagem de erro.
+int  geminiClientAsk(GeminiClient *c, const char *prompt, char *out);
+
+// ----- Requisições assíncronas (curl multi) -----
+// respt() trava quem chama durante a ida e volta inteira. Aqui nada
+// bloqueia: geminiAsyncPoll() avança as transferências o que der (DNS,
+// conexão, TLS, envio, recebimento) e volta na hora, então o jogo chama uma
+// vez por frame sem perder os 60 FPS. O callback roda dentro do poll, na
+// thread que chamou.
+
+#define GEMINI_MAX_PENDING 4   // requisições em andamento ao mesmo tempo
+
+// 'ok' = 1 se 'resposta' é o texto do modelo; senão é a mensagem de erro
+// (rede, HTTP ou JSON), como em respt().
+typedef void (*GeminiCallback)(int id, int ok, const char *resposta, void *user);
+
+// Cada posição guarda o seu handle entre as requisições; as conexões
+// ficam no cache do multi e são divididas entre elas (HTTP/2).
+typedef struct {
+    void          *easy;       // CURL *, criado no primeiro uso
+    int            busy;
+    int            id;
+    char          *body;       // JSON enviado (o curl não copia)
+    StringBuf      resp;
+    GeminiCallback callback;
+    void          *user;
+} GeminiRequest;
+
+typedef struct {
+    void              *multi;  // CURLM *
+    void              *hdrs;   // struct curl_slist *
+    GeminiRequest      requests[GEMINI_MAX_PENDING];
+    int                pending;
+    int                nextId;
+} GeminiAsync;
+
+// Retorna 0 em caso de sucesso, -1 se o curl não iniciar.
+int  geminiAsyncInit(GeminiAsync *g);
+// Cancela o que estiver pendente (sem chamar os callbacks) e libera tudo.
+void geminiAsyncFree(GeminiAsync *g);
+
+// Enfileira 'prompt'. Retorna o id da requisição (> 0) ou -1 se já há
+// GEMINI_MAX_PENDING em andamento ou o curl falhou.
+int  geminiAsyncSubmit(GeminiAsync *g, const char *prompt, GeminiCallback callback, void *user);
+
+// Avança as transferências sem esperar e chama o callback das que
+// terminaram. Uma transferência parada termina em GEMINI_TIMEOUT segundos,
+// com ok = 0 no callback, e libera a sua posição. Retorna quantas
+// continuam pendentes.
+int  geminiAsyncPoll(GeminiAsync *g);
 
-#endif
\ No newline at end of file
+#endif
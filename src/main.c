@@ -7,28 +7,22 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdio.h>
+#include "galton.h"
+#include "binomial.h"
+#include "sim.h"
+#include "boardlayers.h"
+#include "ballrender.h"
+#include "textcache.h"
+#include "profiler.h"
+#include "trace.h"
+#include "gemini.h"
 
 // Definições do Jogo
 #define NUM_PINS_X 12
 #define NUM_PINS_Y 9
-#define PIN_SPACING 60
-#define PIN_RADIUS 5
-#define BALL_RADIUS 11
-#define GRAVITY 500.0f
 #define SLOT_COUNT (NUM_PINS_X + 1)
 #define NUM_ETAPAS 5 // Define 5 etapas
-
-// Structs
-typedef struct {
-    float x, y;
-    float vx, vy;
-    int   active;
-    int   slotIndex;
-} Ball;
-
-typedef struct {
-    float x, y;
-} Pin;
+#define TRACE_FILE "trace.json"
 
 
 // --- NOVO (BLOCO A): Lógica de Perguntas e Estados ---
@@ -81,22 +75,24 @@ Pergunta perguntas[NUM_ETAPAS] = {
 // --- FIM DO BLOCO A ---
 
 
-// --- BLOCO 1: Funções de "Matemática" (Fatorial, Combinações) ---
-long long factorial(int n) {
-    if (n < 0) return 0;
-    if (n == 0) return 1;
-    long long f = 1;
-    for (int i = 2; i <= n; i++) f *= i;
-    return f;
+// Comentário do Gemini sobre a última bola, pedido sem travar o jogo
+// (geminiAsyncSubmit) e preenchido pelo callback dentro do poll do frame
+typedef struct {
+    int  request;              // id da requisição esperada
+    int  serial;               // muda a cada comentário (chave do textcache)
+    char texto[MAX_RESPOSTA];
+} Comentario;
+
+static void onComentario(int id, int ok, const char *resposta, void *user) {
+    Comentario *c = (Comentario *)user;
+    // Resposta de uma jogada anterior, ou erro: fica sem comentário
+    if (id != c->request || !ok) return;
+    snprintf(c->texto, sizeof(c->texto), "%s", resposta);
+    c->serial++;
 }
 
-long long combinations(int n, int k) {
-    if (k < 0 || k > n) return 0;
-    long long denom = factorial(k) * factorial(n - k);
-    if (denom == 0) return 0;
-    return factorial(n) / denom;
-}
-// --- FIM DO BLOCO 1 ---
+
+// --- BLOCO 1: Funções de "Matemática" (Fatorial, Combinações) ficam em binomial.c ---
 
 
 int main(void) {
@@ -106,32 +102,15 @@ int main(void) {
     const int gameAreaHeight = 700; 
 
     InitWindow(screenWidth, screenHeight, "The Wall (Trabalho de Estatística)");
-    srand((unsigned)time(NULL));
     SetTargetFPS(60);
 
-    // ----- Cria Pinos -----
-    Pin pins[NUM_PINS_X * NUM_PINS_Y];
-    int pinCount = 0;
-    float firstPinY = 100.0f;
-    float totalPinsWidth = (NUM_PINS_X - 1) * PIN_SPACING + PIN_RADIUS * 2; 
-    // Calcula o ponto inicial X para que o tabuleiro fique centralizado
-    float initialPinX = (screenWidth - totalPinsWidth) / 2.0f;
-    for (int y = 0; y < NUM_PINS_Y; y++) {
-        for (int x = 0; x < NUM_PINS_X; x++) {
-            float offset = (y % 2 == 0) ? 0 : PIN_SPACING / 2.0f;
-            pins[pinCount].x = screenWidth / 2.0f - NUM_PINS_X * PIN_SPACING / 2 + offset + x * PIN_SPACING;
-            pins[pinCount].y = firstPinY + y * PIN_SPACING;
-            pinCount++;
-        }
+    // ----- Cria Pinos e Slots (motor em galton.c) -----
+    GaltonBoard board;
+    if (galtonInitBoard(&board, NUM_PINS_X, NUM_PINS_Y, screenWidth) != 0) {
+        CloseWindow();
+        return 1;
     }
     
-    // ----- Cria Slots -----
-    float slotWidth = PIN_SPACING;
-    float baseY = 640; 
-    float totalSlotsWidth = SLOT_COUNT * slotWidth; 
-    // Calcula o ponto inicial X para que os slots fiquem centralizados
-    float firstSlotX = (screenWidth - totalSlotsWidth) / 2.0f;
-    
     // --- MUDANÇA: Define valores dos slots (apenas positivos) ---
     int slotValues[SLOT_COUNT]; // SLOT_COUNT é 12
     
@@ -145,13 +124,81 @@ int main(void) {
 
 
     // --- BLOCO 2: Variáveis de Estatística e Jogo ---
-    int slotCounts[SLOT_COUNT] = {0}; 
-    int totalBolas = 0;
-    Ball ball = {0};
-    ball.active = 0;
+    // Distribuição esperada das aterrissagens, a binomial das barras
+    // vermelhas (k caminhos para a direita cai no slot k + 1)
+    double expectedSlots[SLOT_COUNT] = {0};
+    const double *binomialSlots = binomialPmf(NUM_PINS_Y);
+    for (int k = 0; binomialSlots && k <= NUM_PINS_Y && k + 1 < SLOT_COUNT; k++) expectedSlots[k + 1] = binomialSlots[k];
+    // O qui2 e o KL do painel também comparam com ela; os slots que ela dá
+    // como impossíveis (0, 11 e 12) entram junto com o vizinho (runstats.c)
+
+    // Bola, contagens, estatísticas (runstats.c) e previsão (prediction.c,
+    // rollout.c) ficam na thread da simulação (sim.c). Daqui em diante o
+    // loop só manda comandos e desenha a foto mais recente.
+    // (static: as fotos levam as posições da chuva e não cabem bem na pilha)
+    static Simulation sim;
+    if (simInit(&sim, &board, expectedSlots, (unsigned long long)time(NULL)) != 0) {
+        galtonFreeBoard(&board);
+        CloseWindow();
+        return 1;
+    }
+    unsigned long long landingsAtDrop = 0; // aterrissagens antes da bola atual
+    double lastPhysicsMs = 0.0;            // acumulados da foto anterior (profiler)
+    long long lastPinTests = 0;
+
+    // Tabuleiro e moldura do painel desenhados uma vez em texturas
+    // (boardlayers.c); só são redesenhados quando slotColor muda
+    BoardLayers layers;
+    if (boardLayersInit(&layers, screenWidth, screenHeight, gameAreaHeight) != 0) {
+        simFree(&sim);
+        galtonFreeBoard(&board);
+        CloseWindow();
+        return 1;
+    }
+
+    // Bolas desenhadas como quadrados texturizados num único lote do rlgl
+    // (ballrender.c), com o mesmo custo para uma ou milhares
+    BallRenderer ballRenderer;
+    if (ballRendererInit(&ballRenderer, BALL_RADIUS) != 0) {
+        boardLayersFree(&layers);
+        simFree(&sim);
+        galtonFreeBoard(&board);
+        CloseWindow();
+        return 1;
+    }
+
+    // Textos da interface já formatados e medidos (textcache.c); só são
+    // refeitos quando o valor mostrado muda
+    CachedText scoreText = {0}, stageText = {0}, statsText = {0}, finalScoreText = {0};
+    CachedText countText[SLOT_COUNT] = {{0}};
+    CachedText startText[3] = {{0}};
+    CachedText questionText[4] = {{0}};
+    CachedText landedText[2] = {{0}};
+    CachedText rainText = {0};
+
+    // Tempo de cada fase do frame (profiler.c); F3 liga o painel
+    Profiler profiler;
+    profilerInit(&profiler, 1000.0 / 60.0);
+    int showProfiler = 0;
+    // C liga/desliga o modo chuva (rain.c): milhares de bolas caindo ao
+    // mesmo tempo, em qualquer tela do jogo
+    int rainOn = 0;
+    // F4 liga a gravação do trace (trace.c); F4 de novo (ou fechar o jogo)
+    // grava TRACE_FILE para abrir em ui.perfetto.dev / chrome://tracing
+    traceThreadName("jogo");
+
+    // Requisições ao Gemini pelo curl multi (gemini.c): o loop só chama o
+    // poll, então a ida e volta não congela o desenho nem o teclado
+    GeminiAsync gemini;
+    // (só com chave configurada em gemini.c; sem ela toda bola geraria um
+    // pedido que falha)
+    int geminiOk = geminiConfigured() && geminiAsyncInit(&gemini) == 0;
+    Comentario comentario = {0};
+    CachedText comentarioText = {0};
 
     // --- NOVO (BLOCO B): Variáveis de Estado do Jogo ---
     GameState currentState = STATE_START_SCREEN;
+    int eventWaiting = 0; // 1 enquanto EnableEventWaiting() está ligado
     int currentStage = 0; // Etapa atual (de 0 a 4)
     long long totalScore = 0;
     int lastAnswerWasCorrect = 0; // 1 se acertou, 0 se errou
@@ -162,11 +209,28 @@ int main(void) {
 
     // ----- Loop principal -----
     while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        
+        profilerBegin(&profiler, PROF_FRAME);
+        const SimSnapshot *snap = simLatest(&sim);
+        int drawItems = 0;
+        if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;
+        if (IsKeyPressed(KEY_C)) {
+            rainOn = !rainOn;
+            simSetRain(&sim, rainOn);
+        }
+        if (IsKeyPressed(KEY_F4)) {
+            if (!traceEnabled()) {
+                traceSetEnabled(1);
+            } else {
+                traceSetEnabled(0);
+                long events = traceWrite(TRACE_FILE);
+                printf("Trace: %ld eventos em %s (%ld perdidos)\n", events, TRACE_FILE, traceDropped());
+            }
+        }
 
         // ##### 1. ATUALIZAÇÃO (LÓGICA DO JOGO) #####
         
+        profilerBegin(&profiler, PROF_UPDATE);
+        if (geminiOk) geminiAsyncPoll(&gemini);
         switch (currentState) {
             case STATE_START_SCREEN: {
                 // Espera o jogador pressionar ENTER para começar
@@ -196,71 +260,35 @@ int main(void) {
 
             case STATE_WAITING_FOR_BALL: {
                 // Espera o jogador pressionar ESPAÇO para soltar a bola
-                if (IsKeyPressed(KEY_SPACE) && !ball.active) {
-                    ball.x = screenWidth / 2.0f;
-                    ball.y = 40;
-                    ball.vx = 0;
-                    ball.vy = 0;
-                    ball.active = 1;
-                    ball.slotIndex = -1;
+                if (IsKeyPressed(KEY_SPACE) && !snap->ball.active) {
+                    landingsAtDrop = snap->landings;
+                    simDropBall(&sim);
                     currentState = STATE_BALL_FALLING;
                 }
             } break;
 
             case STATE_BALL_FALLING: {
-                // Física da bola
-                if (ball.active) {
-                    ball.vy += GRAVITY * dt;
-                    ball.x += ball.vx * dt;
-                    ball.y += ball.vy * dt;
-                    for (int i = 0; i < pinCount; i++) {
-                        float dx = ball.x - pins[i].x;
-                        float dy = ball.y - pins[i].y;
-                        float dist = sqrtf(dx*dx + dy*dy);
-                        float minDist = BALL_RADIUS + PIN_RADIUS;
-                        if (dist < minDist && dist > 0.0001f) {
-                            float nx = dx / dist;
-                            float ny = dy / dist;
-                            float pen = minDist - dist;
-                            ball.x += nx * pen;
-                            ball.y += ny * pen;
-                            float vDotN = ball.vx * nx + ball.vy * ny;
-                            ball.vx = ball.vx - 2.0f * vDotN * nx;
-                            ball.vy = ball.vy - 2.0f * vDotN * ny;
-                            ball.vx *= 0.6f;
-                            ball.vy *= 0.6f;
-                            ball.vx += ((rand() % 200) - 100) / 100.0f * 40.0f;
-                            break;
-                        }
+                // A física roda em sim.c; aqui só espera a foto da aterrissagem
+                if (snap->landings > landingsAtDrop) {
+                    // --- NOVO (BLOCO C): ATUALIZA PONTUAÇÃO ---
+                    lastValue = slotValues[snap->lastSlot];
+                    if (lastAnswerWasCorrect) {
+                        totalScore += lastValue; // Acertou: SOMA
+                    } else {
+                        totalScore -= lastValue; // Errou: SUBTRAI
                     }
-                    if (ball.x < BALL_RADIUS) { ball.x = BALL_RADIUS; ball.vx *= -0.6f; }
-                    if (ball.x > screenWidth - BALL_RADIUS) { ball.x = screenWidth - BALL_RADIUS; ball.vx *= -0.6f; }
-
-                    // Bola Aterrissou!
-                    if (ball.y > baseY - BALL_RADIUS) {
-                        ball.y = baseY - BALL_RADIUS;
-                        int idx = (int)((ball.x - firstSlotX) / slotWidth);
-                        if (idx < 0) idx = 0;
-                        if (idx >= SLOT_COUNT) idx = SLOT_COUNT - 1;
-                        
-                        ball.slotIndex = idx;
-                        ball.active = 0;
-
-                        // ATUALIZA ESTATÍSTICA (BLOCO 3)
-                        slotCounts[idx]++; 
-                        totalBolas++;
-                        
-                        // --- NOVO (BLOCO C): ATUALIZA PONTUAÇÃO ---
-                        lastValue = slotValues[ball.slotIndex];
-                        if (lastAnswerWasCorrect) {
-                            totalScore += lastValue; // Acertou: SOMA
-                        } else {
-                            totalScore -= lastValue; // Errou: SUBTRAI
-                        }
-                        // --- FIM DO BLOCO C ---
-                        
-                        currentState = STATE_BALL_LANDED;
+                    // --- FIM DO BLOCO C ---
+
+                    comentario.texto[0] = '\0';
+                    if (geminiOk) {
+                        comentario.request = geminiAsyncSubmit(&gemini,
+                            TextFormat("Em uma frase de no maximo 80 caracteres, comente: a bola do "
+                                       "tabuleiro de Galton caiu no valor %d e o jogador %s a pergunta.",
+                                       lastValue, lastAnswerWasCorrect ? "acertou" : "errou"),
+                            onComentario, &comentario);
                     }
+
+                    currentState = STATE_BALL_LANDED;
                 }
             } break;
 
@@ -285,98 +313,138 @@ int main(void) {
                     currentStage = 0;
                     currentState = STATE_ASKING_QUESTION;
                     slotColor = BLUE; // <--- MUDANÇA: Reseta cor
-                    totalBolas = 0;
-                    for (int i = 0; i < SLOT_COUNT; i++) slotCounts[i] = 0;
+                    simResetStats(&sim);
                 }
             } break;
         }
+        profilerEnd(&profiler, PROF_UPDATE);
+        // A física roda na outra thread: entra no perfil o que ela gastou
+        // desde a foto anterior
+        profilerAddTime(&profiler, PROF_PHYSICS, snap->physicsMs - lastPhysicsMs);
+        profilerCount(&profiler, PROF_PIN_TESTS, snap->pinTests - lastPinTests);
+        profilerCount(&profiler, PROF_BALLS, (snap->ball.active ? 1 : 0) + snap->rainCount);
+        lastPhysicsMs = snap->physicsMs;
+        lastPinTests = snap->pinTests;
 
 
         // ##### 2. DESENHO (GRÁFICOS) #####
         
+        // Fora da queda (e sem chuva) nada se mexe: o raylib passa a esperar
+        // um evento (tecla, mouse, janela) em EndDrawing() em vez de
+        // redesenhar a 60 FPS
+        // (nem com resposta do Gemini pendente: o poll só roda se o loop rodar)
+        int animating = (currentState == STATE_BALL_FALLING) || rainOn || snap->rainCount > 0 ||
+                        (geminiOk && gemini.pending > 0);
+        if (animating && eventWaiting) {
+            DisableEventWaiting();
+            eventWaiting = 0;
+        } else if (!animating && !eventWaiting) {
+            EnableEventWaiting();
+            eventWaiting = 1;
+        }
+
+        boardLayersUpdate(&layers, &board, slotValues, slotColor, GetScreenWidth(), GetScreenHeight());
+
         BeginDrawing();
         ClearBackground((Color){5,15,40,255});
 
-        // --- Desenha o Jogo (Pinos, Slots, Fundo) ---
-        for (int i = 0; i < pinCount; i++)
-            DrawCircle((int)pins[i].x, (int)pins[i].y, PIN_RADIUS, RAYWHITE);
-        
-        DrawRectangle(0, baseY, screenWidth, gameAreaHeight - baseY, DARKGRAY);
-        for (int i = 0; i < SLOT_COUNT; i++) {
-            float x = firstSlotX + i * slotWidth;
-            DrawLine(x, baseY, x, gameAreaHeight, RAYWHITE);
-            char txt[16];
-            sprintf(txt, "%d", slotValues[i]);
-            
-            // --- MUDANÇA (Usa a variável de cor 'slotColor') ---
-            DrawText(txt, x + slotWidth/2 - 20, baseY + 15, 16, slotColor);
-        }
+        // --- Desenha o Jogo (Pinos, Slots, Fundo) e a moldura do painel ---
+        boardLayersDraw(&layers);
+        drawItems += 2;
 
         // --- Desenha a Bola (se estiver caindo) ---
-        if (ball.active) {
-            DrawCircle((int)ball.x, (int)ball.y, BALL_RADIUS, GOLD);
+        if (snap->ball.active) {
+            // Interpola entre os dois últimos passos da física
+            float alpha = simAlpha(snap, profilerNow());
+            float drawX = snap->prevBall.x + (snap->ball.x - snap->prevBall.x) * alpha;
+            float drawY = snap->prevBall.y + (snap->ball.y - snap->prevBall.y) * alpha;
+            drawItems += ballRendererDraw(&ballRenderer, &drawX, &drawY, 1, GOLD);
+        }
+        // Chuva: posições do último passo, sem interpolar
+        if (snap->rainCount > 0) {
+            drawItems += ballRendererDraw(&ballRenderer, snap->rainX, snap->rainY, snap->rainCount, SKYBLUE);
         }
 
         // --- Desenha a Área de Estatística (sempre visível) ---
-        DrawRectangle(0, gameAreaHeight, screenWidth, screenHeight - gameAreaHeight, (Color){10, 20, 50, 255});
-        DrawLine(0, gameAreaHeight, screenWidth, gameAreaHeight, RAYWHITE);
-        DrawText("DISTRIBUIÇÃO DE PROBABILIDADE (EM TEMPO REAL)", 110, gameAreaHeight + 15, 20, YELLOW);
+        if (snap->statsN > 0) {
+            // 'statsSerial' nunca se repete (nem depois de zerar com R)
+            if (textCacheStale(&statsText, NULL, (long long)snap->statsSerial, 14)) {
+                textCacheSet(&statsText, TextFormat("n=%llu  media=%.2f  var=%.2f  assimetria=%.2f  qui2=%.1f  KL=%.3f",
+                                                    snap->statsN, snap->mean, snap->variance,
+                                                    snap->skewness, snap->chiSquare, snap->kl));
+            }
+            textCacheDraw(&statsText, 110, gameAreaHeight + 40, LIGHTGRAY);
+        }
         
         // BLOCO 4: Gráficos (Empírico e Teórico)
+        profilerBegin(&profiler, PROF_GRAPHS);
         float graphBaseY = screenHeight - 30; 
         float graphAreaWidth = 600;           
         float graphStartX = (screenWidth - graphAreaWidth) / 2;
         float graphBarWidth = graphAreaWidth / SLOT_COUNT;
-        int scaleFactor = 20; 
+        // 20 px por bola enquanto cabe; com a chuva a escala diminui para a
+        // barra mais alta (empírica ou teórica) caber no painel
+        float graphMaxHeight = graphBaseY - gameAreaHeight - 80;
+        double tallest = 0.0;
+        for (int i = 0; i < SLOT_COUNT; i++) {
+            double expected = expectedSlots[i] * snap->totalBolas;
+            if ((double)snap->slotCounts[i] > tallest) tallest = (double)snap->slotCounts[i];
+            if (expected > tallest) tallest = expected;
+        }
+        float scaleFactor = 20.0f;
+        if (tallest * scaleFactor > graphMaxHeight) scaleFactor = graphMaxHeight / tallest;
         // 4a. Empírico (AZUL)
         for (int i = 0; i < SLOT_COUNT; i++) {
             float x = graphStartX + i * graphBarWidth;
-            int height = slotCounts[i] * scaleFactor;
+            int height = (int)((double)snap->slotCounts[i] * scaleFactor);
             DrawRectangle(x + 2, graphBaseY - height, graphBarWidth - 4, height, BLUE);
-            DrawText(TextFormat("%d", slotCounts[i]), x + graphBarWidth/2 - 5, graphBaseY - height - 15, 14, RAYWHITE);
+            drawItems++;
+            textCacheDraw(textCacheInt(&countText[i], "%lld", (long long)snap->slotCounts[i], 14), x + graphBarWidth/2 - 5, graphBaseY - height - 15, RAYWHITE);
         }
         // 4b. Teórico (VERMELHO)
-        if (totalBolas > 0) {
+        // (expectedSlots: a tabela do binomial.c é da thread da simulação agora)
+        if (snap->totalBolas > 0) {
             int n_rows = NUM_PINS_Y;
             for (int k = 0; k <= n_rows; k++) {
                 int slotIndex = k + 1; 
-                double prob = (double)combinations(n_rows, k) * pow(0.5, n_rows);
-                int expectedHeight = (int)(prob * totalBolas * scaleFactor);
+                double prob = expectedSlots[slotIndex];
+                int expectedHeight = (int)(prob * (double)snap->totalBolas * scaleFactor);
                 float x = graphStartX + slotIndex * graphBarWidth;
                 DrawRectangleLines(x + 2, graphBaseY - expectedHeight, graphBarWidth - 4, expectedHeight, RED);
+                drawItems++;
             }
         }
+        profilerEnd(&profiler, PROF_GRAPHS);
         
         // BLOCO 5: Previsão Dinâmica (VERDE)
-        if (ball.active) {
-            float progress = (ball.y - firstPinY) / (baseY - firstPinY);
-            if (progress < 0.0f) progress = 0.0f;
-            if (progress > 1.0f) progress = 1.0f;
-            int n_remaining = (int)((1.0f - progress) * NUM_PINS_Y);
-            if (n_remaining < 1) n_remaining = 1;
-            float predictedX = ball.x;
-            int center_slot_idx = (int)((predictedX - firstSlotX) / slotWidth);
-            int k_peak = n_remaining / 2;
-            int slot_offset = center_slot_idx - k_peak;
+        profilerBegin(&profiler, PROF_PREDICTION);
+        if (snap->ball.active && snap->hasPrediction) {
+            const double *probs = snap->prediction;
             int graphHeight = (screenHeight - gameAreaHeight - 60);
-            for (int k = 0; k <= n_remaining; k++) {
-                double prob = (double)combinations(n_remaining, k) * pow(0.5, n_remaining);
-                int probHeight = (int)(prob * (graphHeight * 2.0));
-                int target_slot = k + slot_offset;
-                if (target_slot >= 0 && target_slot < SLOT_COUNT) {
-                    float x = graphStartX + target_slot * graphBarWidth;
-                    DrawRectangle(x + 2, graphBaseY - probHeight, graphBarWidth - 4, probHeight, Fade(GREEN, 0.4f));
-                }
+            for (int i = 0; i < SLOT_COUNT; i++) {
+                if (probs[i] <= 0.0) continue;
+                int probHeight = (int)(probs[i] * (graphHeight * 2.0));
+                float x = graphStartX + i * graphBarWidth;
+                DrawRectangle(x + 2, graphBaseY - probHeight, graphBarWidth - 4, probHeight, Fade(GREEN, 0.4f));
+                drawItems++;
             }
         }
+        profilerEnd(&profiler, PROF_PREDICTION);
 
         // --- NOVO (BLOCO D): Desenha a Interface do Jogo (UI) ---
         // Esta parte desenha o texto de acordo com o estado do jogo
         
+        profilerBegin(&profiler, PROF_UI);
         // Desenha a Pontuação Total e a Etapa (quase sempre visível)
         if (currentState != STATE_GAME_OVER && currentState != STATE_START_SCREEN) {
-            DrawText(TextFormat("PONTUACAO: %lld", totalScore), 20, 20, 24, YELLOW);
-            DrawText(TextFormat("ETAPA: %d / %d", currentStage + 1, NUM_ETAPAS), 620, 20, 24, YELLOW);
+            textCacheDraw(textCacheInt(&scoreText, "PONTUACAO: %lld", totalScore, 24), 20, 20, YELLOW);
+            if (textCacheStale(&stageText, NULL, currentStage, 24)) {
+                textCacheSet(&stageText, TextFormat("ETAPA: %d / %d", currentStage + 1, NUM_ETAPAS));
+            }
+            textCacheDraw(&stageText, 620, 20, YELLOW);
+        }
+        if (rainOn || snap->rainCount > 0) {
+            textCacheDraw(textCacheInt(&rainText, "CHUVA: %lld bolas", snap->rainCount, 20), 20, 50, SKYBLUE);
         }
 
         switch (currentState) {
@@ -385,11 +453,11 @@ int main(void) {
                 DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.7f));
                 
                 // Título
-                DrawText("THE WALL", (screenWidth - MeasureText("THE WALL", 80)) / 2, 250, 80, GOLD);
-                DrawText("Trabalho de Estatistica", (screenWidth - MeasureText("Trabalho de Estatistica", 30)) / 2, 340, 30, RAYWHITE);
+                textCacheDrawCentered(textCacheStatic(&startText[0], "THE WALL", 80), screenWidth, 250, GOLD);
+                textCacheDrawCentered(textCacheStatic(&startText[1], "Trabalho de Estatistica", 30), screenWidth, 340, RAYWHITE);
                 
                 // Instrução
-                DrawText("Pressione [ENTER] para comecar", (screenWidth - MeasureText("Pressione [ENTER] para comecar", 20)) / 2, 450, 20, YELLOW);
+                textCacheDrawCentered(textCacheStatic(&startText[2], "Pressione [ENTER] para comecar", 20), screenWidth, 450, YELLOW);
                 
             } break;
 
@@ -397,10 +465,10 @@ int main(void) {
                 DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.7f));
                 // Desenha a pergunta e as opções
                 Pergunta q = perguntas[currentStage];
-                DrawText(q.texto, (screenWidth - MeasureText(q.texto, 20)) / 2, 60, 20, WHITE);
-                DrawText(q.opcoes[0], (screenWidth - MeasureText(q.opcoes[0], 20)) / 2, 90, 20, RAYWHITE);
-                DrawText(q.opcoes[1], (screenWidth - MeasureText(q.opcoes[1], 20)) / 2, 120, 20, RAYWHITE);
-                DrawText(q.opcoes[2], (screenWidth - MeasureText(q.opcoes[2], 20)) / 2, 150, 20, RAYWHITE);
+                textCacheDrawCentered(textCacheStatic(&questionText[0], q.texto, 20), screenWidth, 60, WHITE);
+                textCacheDrawCentered(textCacheStatic(&questionText[1], q.opcoes[0], 20), screenWidth, 90, RAYWHITE);
+                textCacheDrawCentered(textCacheStatic(&questionText[2], q.opcoes[1], 20), screenWidth, 120, RAYWHITE);
+                textCacheDrawCentered(textCacheStatic(&questionText[3], q.opcoes[2], 20), screenWidth, 150, RAYWHITE);
                 DrawText("Pressione [1], [2] ou [3] para responder", 210, 190, 20, LIME);
             } break;
 
@@ -422,33 +490,97 @@ int main(void) {
 
             case STATE_BALL_LANDED: {
                 // Mostra o resultado da jogada
-                char* resultadoTexto;
+                const char* resultadoFormato;
                 Color resultadoCor;
                 
                 if (lastAnswerWasCorrect) {
-                    resultadoTexto = TextFormat("Voce GANHOU %d pontos!", lastValue);
+                    resultadoFormato = "Voce GANHOU %lld pontos!";
                     resultadoCor = GREEN;
                 } else {
-                    resultadoTexto = TextFormat("Voce PERDEU %d pontos!", lastValue);
+                    resultadoFormato = "Voce PERDEU %lld pontos!";
                     resultadoCor = RED;
                 }
-                DrawText(TextFormat("A bola caiu no valor: %d", lastValue), 220, 80, 20, RAYWHITE);
-                DrawText(resultadoTexto, (screenWidth - MeasureText(resultadoTexto, 24)) / 2, 110, 24, resultadoCor);
+                textCacheDraw(textCacheInt(&landedText[0], "A bola caiu no valor: %lld", lastValue, 20), 220, 80, RAYWHITE);
+                textCacheDrawCentered(textCacheInt(&landedText[1], resultadoFormato, lastValue, 24), screenWidth, 110, resultadoCor);
                 DrawText("Pressione [ENTER] para a proxima etapa...", 170, 160, 20, YELLOW);
+                if (comentario.texto[0] != '\0') {
+                    if (textCacheStale(&comentarioText, NULL, comentario.serial, 18)) {
+                        textCacheSet(&comentarioText, comentario.texto);
+                    }
+                    textCacheDrawCentered(&comentarioText, screenWidth, 190, LIGHTGRAY);
+                }
             } break;
 
             case STATE_GAME_OVER: {
                 // Tela de Fim de Jogo
                 DrawText("FIM DE JOGO!", 280, 100, 40, GOLD);
-                DrawText(TextFormat("PONTUACAO FINAL: %lld", totalScore), (screenWidth - MeasureText(TextFormat("PONTUACAO FINAL: %lld", totalScore), 30)) / 2, 160, 30, YELLOW);
+                textCacheDrawCentered(textCacheInt(&finalScoreText, "PONTUACAO FINAL: %lld", totalScore, 30), screenWidth, 160, YELLOW);
                 DrawText("Pressione [R] para reiniciar o jogo", 210, 220, 20, RAYWHITE);
             } break;
         }
+        profilerEnd(&profiler, PROF_UI);
         // --- FIM DO BLOCO D ---
 
+        // --- BLOCO E: Painel de desempenho (F3) ---
+        // Percentis de cada fase nos últimos PROFILER_FRAMES frames, picos
+        // acima de 16,6 ms e contadores (último frame / média)
+        if (showProfiler) {
+            int px = 470, py = 60;
+            DrawRectangle(px - 10, py - 10, 330, 250, Fade(BLACK, 0.8f));
+            DrawText("fase", px, py, 14, GOLD);
+            DrawText("p50", px + 100, py, 14, GOLD);
+            DrawText("p95", px + 150, py, 14, GOLD);
+            DrawText("p99", px + 200, py, 14, GOLD);
+            DrawText("max (ms)", px + 250, py, 14, GOLD);
+            for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+                int y = py + 20 + p * 18;
+                DrawText(profilerPhaseNames[p], px, y, 14, RAYWHITE);
+                DrawText(TextFormat("%.2f", profilerPercentile(&profiler, p, 50.0)), px + 100, y, 14, RAYWHITE);
+                DrawText(TextFormat("%.2f", profilerPercentile(&profiler, p, 95.0)), px + 150, y, 14, RAYWHITE);
+                DrawText(TextFormat("%.2f", profilerPercentile(&profiler, p, 99.0)), px + 200, y, 14, RAYWHITE);
+                DrawText(TextFormat("%.2f", profilerMax(&profiler, p)), px + 250, y, 14, RAYWHITE);
+            }
+            int y = py + 30 + PROF_PHASE_COUNT * 18;
+            DrawText(TextFormat("picos > %.1f ms: %d de %d frames", profiler.budgetMs, profilerSpikes(&profiler), profiler.filled),
+                     px, y, 14, profilerSpikes(&profiler) > 0 ? RED : LIME);
+            for (int c = 0; c < PROF_COUNTER_COUNT; c++) {
+                DrawText(TextFormat("%s: %lld (media %.1f)", profilerCounterNames[c],
+                                    profilerCounterLast(&profiler, c), profilerCounterMean(&profiler, c)),
+                         px, y + 20 + c * 18, 14, RAYWHITE);
+            }
+        }
+
+        profilerCount(&profiler, PROF_DRAW_ITEMS, drawItems + textCacheTakeDrawCount());
+
+        // O frame só fecha depois do EndDrawing, para que o envio ao driver,
+        // a troca de buffer e o vsync entrem nos picos. Com a espera por
+        // eventos ligada o EndDrawing fica parado até chegar entrada; esse
+        // tempo não é frame, então o frame é descartado.
+        profilerBegin(&profiler, PROF_PRESENT);
         EndDrawing();
+        profilerEnd(&profiler, PROF_PRESENT);
+        profilerEnd(&profiler, PROF_FRAME);
+        if (eventWaiting) profilerDiscardFrame(&profiler);
+        else profilerEndFrame(&profiler);
     }
 
+    if (geminiOk) geminiAsyncFree(&gemini);
+    simFree(&sim);
+    galtonFreeBoard(&board);
+    if (traceEnabled()) {
+        traceSetEnabled(0);
+        traceWrite(TRACE_FILE);
+    }
+    traceShutdown();
+    CachedText *texts[] = { &scoreText, &stageText, &statsText, &finalScoreText, &rainText, &comentarioText };
+    for (int i = 0; i < (int)(sizeof(texts) / sizeof(texts[0])); i++) textCacheFree(texts[i]);
+    for (int i = 0; i < SLOT_COUNT; i++) textCacheFree(&countText[i]);
+    for (int i = 0; i < 3; i++) textCacheFree(&startText[i]);
+    for (int i = 0; i < 4; i++) textCacheFree(&questionText[i]);
+    for (int i = 0; i < 2; i++) textCacheFree(&landedText[i]);
+    ballRendererFree(&ballRenderer);
+    boardLayersFree(&layers);
+    binomialFreeTables();
     CloseWindow();
-    return 0;
+    return 0;
 }
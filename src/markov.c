@@ -0,0 +1,297 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "markov.h"
+
+#define JITTER_LEVELS 200          // mesmos 200 valores de galtonJitter()
+#define MAX_SWEEPS 64              // varreduras de cima para baixo (bolas que sobem uma fileira)
+#define MAX_FLIGHT_EVENTS 64       // batidas em parede num voo por eventos, no máximo
+#define PI_F 3.14159265358979f
+
+// Massa acumulada num estado discreto (pino, ângulo, vx, vy). Além da massa
+// guarda as somas ponderadas do estado exato, e o voo seguinte parte do
+// estado médio do balde em vez do centro dele: isso evita que o
+// arredondamento espalhe a distribuição a cada batida.
+typedef struct {
+    uint32_t cell;    // pino * keys + key + 1 (0 = vazio)
+    double   mass;
+    double   angle, vx, vy;
+} Entry;
+
+// Mapa hash cell -> Entry (só uma fração pequena dos estados recebe massa)
+typedef struct {
+    Entry   *slots;
+    uint32_t capacity;  // potência de 2
+    uint32_t used;
+} MassMap;
+
+typedef struct {
+    const GaltonBoard  *board;
+    const MarkovConfig *config;
+    int     keys;              // angleBins * velBins * velBins
+    float   jitter[JITTER_LEVELS];
+    double  jitterWeight[JITTER_LEVELS];
+    int     jitterCount;
+    MassMap *rows;             // um mapa por fileira de pinos
+    double *slotProbs;
+} Solver;
+
+MarkovConfig markovDefaultConfig(void) {
+    MarkovConfig config;
+    config.angleBins    = 12;
+    config.velBins      = 10;
+    config.velMax       = 400.0f;
+    config.jitterPoints = 8;
+    config.minMass      = 1e-7;
+    config.dt           = GALTON_DT;
+    return config;
+}
+
+// ----- Mapa hash -----
+static uint32_t hashCell(uint32_t cell) {
+    cell ^= cell >> 16;
+    cell *= 0x7feb352dU;
+    cell ^= cell >> 15;
+    cell *= 0x846ca68bU;
+    return cell ^ (cell >> 16);
+}
+
+static int mapInit(MassMap *map, uint32_t capacity) {
+    map->capacity = capacity;
+    map->used = 0;
+    map->slots = calloc(capacity, sizeof(Entry));
+    return map->slots ? 0 : -1;
+}
+
+static int mapAdd(MassMap *map, const Entry *e);
+
+static int mapGrow(MassMap *map) {
+    MassMap bigger;
+    if (mapInit(&bigger, map->capacity * 2) != 0) return -1;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (map->slots[i].cell) mapAdd(&bigger, &map->slots[i]);
+    }
+    free(map->slots);
+    *map = bigger;
+    return 0;
+}
+
+static int mapAdd(MassMap *map, const Entry *e) {
+    if ((map->used + 1) * 10 > map->capacity * 7 && mapGrow(map) != 0) return -1;
+    uint32_t mask = map->capacity - 1;
+    for (uint32_t i = hashCell(e->cell) & mask;; i = (i + 1) & mask) {
+        Entry *slot = &map->slots[i];
+        if (slot->cell == 0) {
+            *slot = *e;
+            map->used++;
+            return 0;
+        }
+        if (slot->cell == e->cell) {
+            slot->mass  += e->mass;
+            slot->angle += e->angle;
+            slot->vx    += e->vx;
+            slot->vy    += e->vy;
+            return 0;
+        }
+    }
+}
+
+// ----- Estado de contato -----
+static int binOf(float v, float lo, float hi, int bins) {
+    int b = (int)((v - lo) / (hi - lo) * bins);
+    if (b < 0) b = 0;
+    if (b >= bins) b = bins - 1;
+    return b;
+}
+
+static float pinX(const GaltonBoard *board, int row, int col) {
+    return board->pinOriginX + ((row % 2 == 0) ? 0 : PIN_SPACING / 2.0f) + col * PIN_SPACING;
+}
+
+static float pinY(const GaltonBoard *board, int row) {
+    return board->firstPinY + row * PIN_SPACING;
+}
+
+// Pino mais próximo da bola (a batida acabou de empurrá-la para a
+// distância mínima dele, então é o pino que ela tocou).
+static void nearestPin(const GaltonBoard *board, const Ball *ball, int *row, int *col) {
+    int r = (int)floorf((ball->y - board->firstPinY) / PIN_SPACING + 0.5f);
+    if (r < 0) r = 0;
+    if (r > board->numPinsY - 1) r = board->numPinsY - 1;
+    int c = (int)floorf((ball->x - pinX(board, r, 0)) / PIN_SPACING + 0.5f);
+    if (c < 0) c = 0;
+    if (c > board->numPinsX - 1) c = board->numPinsX - 1;
+    *row = r;
+    *col = c;
+}
+
+// Aplica o desvio e voa até a próxima batida, que vira uma Entry com massa
+// 'mass', ou até a base. Em passos fixos a ordem é a de galtonStepBall():
+// o desvio entra logo depois da batida, antes de galtonSettle().
+// Retorna o slot da aterrissagem, ou -1 se bateu num pino.
+static int fly(const Solver *s, Ball ball, float jitter, double mass, Entry *hit) {
+    const MarkovConfig *c = s->config;
+    ball.vx += jitter;
+    int limit = c->dt > 0.0f ? GALTON_MAX_STEPS : MAX_FLIGHT_EVENTS;
+    for (int i = 0; i < limit; i++) {
+        int pin;
+        if (c->dt > 0.0f) {
+            if (galtonSettle(s->board, &ball)) return ball.slotIndex;
+            pin = galtonIntegrate(s->board, &ball, c->dt);
+        } else {
+            int kind = galtonEventAdvance(s->board, &ball, NULL);
+            if (kind == GALTON_EVENT_LAND) return ball.slotIndex;
+            pin = kind == GALTON_EVENT_PIN;
+        }
+        if (pin) {
+            int row, col;
+            nearestPin(s->board, &ball, &row, &col);
+            float angle = atan2f(ball.y - pinY(s->board, row), ball.x - pinX(s->board, row, col));
+            int key = (binOf(angle, -PI_F, PI_F, c->angleBins) * c->velBins
+                       + binOf(ball.vx, -c->velMax, c->velMax, c->velBins)) * c->velBins
+                       + binOf(ball.vy, -c->velMax, c->velMax, c->velBins);
+            hit->cell  = (uint32_t)(row * s->board->numPinsX + col) * (uint32_t)s->keys + (uint32_t)key + 1;
+            hit->mass  = mass;
+            hit->angle = mass * angle;
+            hit->vx    = mass * ball.vx;
+            hit->vy    = mass * ball.vy;
+            return -1;
+        }
+    }
+    return galtonSlotFromX(s->board, ball.x);
+}
+
+static int rowOfCell(const Solver *s, uint32_t cell) {
+    return (int)((cell - 1) / s->keys) / s->board->numPinsX;
+}
+
+static int addHit(Solver *s, const Entry *hit) {
+    return mapAdd(&s->rows[rowOfCell(s, hit->cell)], hit);
+}
+
+// Leva a massa de um estado adiante, um ramo por valor do desvio
+static int transition(Solver *s, const Entry *e) {
+    int pin = (int)((e->cell - 1) / s->keys);
+    int row = pin / s->board->numPinsX;
+    int col = pin % s->board->numPinsX;
+    const float minDist = BALL_RADIUS + PIN_RADIUS;
+    float angle = (float)(e->angle / e->mass);
+
+    Ball ball;
+    ball.x = pinX(s->board, row, col) + cosf(angle) * minDist;
+    ball.y = pinY(s->board, row) + sinf(angle) * minDist;
+    ball.vx = (float)(e->vx / e->mass);
+    ball.vy = (float)(e->vy / e->mass);
+    ball.active = 1;
+    ball.slotIndex = -1;
+
+    for (int j = 0; j < s->jitterCount; j++) {
+        Entry hit;
+        double mass = e->mass * s->jitterWeight[j];
+        int slot = fly(s, ball, s->jitter[j], mass, &hit);
+        if (slot >= 0) s->slotProbs[slot] += mass;
+        else if (addHit(s, &hit) != 0) return -1;
+    }
+    return 0;
+}
+
+// Agrupa os 200 desvios em 'points' grupos consecutivos (quase) do mesmo
+// tamanho e representa cada grupo pela média, com peso proporcional.
+static void buildJitterQuadrature(Solver *s, int points) {
+    if (points < 1) points = 1;
+    if (points > JITTER_LEVELS) points = JITTER_LEVELS;
+    s->jitterCount = points;
+    for (int j = 0; j < points; j++) {
+        int first = j * JITTER_LEVELS / points;
+        int last = (j + 1) * JITTER_LEVELS / points;
+        double sum = 0.0;
+        for (int k = first; k < last; k++) {
+            sum += (k - JITTER_LEVELS / 2) / (JITTER_LEVELS / 2.0) * BALL_JITTER;
+        }
+        s->jitter[j] = (float)(sum / (last - first));
+        s->jitterWeight[j] = (double)(last - first) / JITTER_LEVELS;
+    }
+}
+
+int markovSolve(const GaltonBoard *board, const MarkovConfig *config, double *slotProbs) {
+    MarkovConfig defaults = markovDefaultConfig();
+    if (!config) config = &defaults;
+
+    Solver s;
+    memset(&s, 0, sizeof(s));
+    s.board = board;
+    s.config = config;
+    s.keys = config->angleBins * config->velBins * config->velBins;
+    s.slotProbs = slotProbs;
+    buildJitterQuadrature(&s, config->jitterPoints);
+    for (int i = 0; i < board->slotCount; i++) slotProbs[i] = 0.0;
+
+    if ((double)board->pinCount * s.keys >= 4e9) return -1;
+    s.rows = calloc(board->numPinsY, sizeof(MassMap));
+    if (!s.rows) return -1;
+    for (int row = 0; row < board->numPinsY; row++) {
+        if (mapInit(&s.rows[row], 1 << 10) != 0) {
+            for (int k = 0; k < row; k++) free(s.rows[k].slots);
+            free(s.rows);
+            return -1;
+        }
+    }
+
+    // Primeira batida: o lançamento é determinístico
+    Ball spawn;
+    galtonSpawnBall(board, &spawn);
+    Entry first;
+    int slot = fly(&s, spawn, 0.0f, 1.0, &first);
+    if (slot >= 0) slotProbs[slot] += 1.0;
+    else addHit(&s, &first);
+
+    // Processa as fileiras de cima para baixo. Dentro de uma fileira repete
+    // até a massa dela acabar (a bola pode quicar de novo na mesma fileira);
+    // a massa que sobe uma fileira é pega na varredura seguinte.
+    Entry *batch = NULL;
+    uint32_t batchCap = 0;
+    int result = 0;
+    for (int sweep = 0; sweep < MAX_SWEEPS && result == 0; sweep++) {
+        int moved = 0;
+        for (int row = 0; row < board->numPinsY && result == 0; row++) {
+            for (;;) {
+                uint32_t n = 0;
+                MassMap *map = &s.rows[row];
+                for (uint32_t i = 0; i < map->capacity; i++) {
+                    Entry *e = &map->slots[i];
+                    if (!e->cell || e->mass <= 0.0) continue;
+                    if (e->mass >= config->minMass) {
+                        if (n == batchCap) {
+                            batchCap = batchCap ? batchCap * 2 : 1024;
+                            Entry *bigger = realloc(batch, sizeof(Entry) * batchCap);
+                            if (!bigger) { result = -1; break; }
+                            batch = bigger;
+                        }
+                        batch[n++] = *e;
+                    }
+                }
+                if (result != 0) break;
+                // Tudo o que estava na fileira foi para o lote (ou descartado)
+                memset(map->slots, 0, sizeof(Entry) * map->capacity);
+                map->used = 0;
+                if (n == 0) break;
+                moved = 1;
+                for (uint32_t i = 0; i < n && result == 0; i++) result = transition(&s, &batch[i]);
+            }
+        }
+        if (!moved) break;
+    }
+
+    // A massa descartada (estados quase impossíveis) volta proporcionalmente
+    double total = 0.0;
+    for (int i = 0; i < board->slotCount; i++) total += slotProbs[i];
+    if (total > 0.0) {
+        for (int i = 0; i < board->slotCount; i++) slotProbs[i] /= total;
+    }
+
+    free(batch);
+    for (int row = 0; row < board->numPinsY; row++) free(s.rows[row].slots);
+    free(s.rows);
+    return result;
+}
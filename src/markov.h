@@ -0,0 +1,40 @@
+#ifndef MARKOV_H
+#define MARKOV_H
+
+#include "galton.h"
+
+// Distribuição de aterrissagem da física real (restituição, desvio, paredes),
+// calculada sem sortear bolas. A cada batida num pino o estado da bola é
+// discretizado em (pino, ângulo do contato, vx, vy); a probabilidade de cada
+// estado é levada adiante abrindo um ramo por valor representativo do
+// desvio e resolvendo o voo determinístico até a próxima batida ou a base,
+// nos mesmos passos fixos de galtonIntegrate()/galtonSettle() do jogo (ou
+// por eventos, com dt = 0). As fileiras são processadas de cima para baixo,
+// então cada estado só é expandido quando já juntou a massa que chega até ele.
+//
+// Não é exato: a discretização perde a fase da bola dentro do passo. Com o
+// padrão, no tabuleiro 12x9, fica a ~1% (distância de variação total) do
+// Monte Carlo de 240 Hz e leva ~1,5 s. O erro por slot contra 2M quedas é
+// de até 0,0035 em valor absoluto; em termos relativos os slots das pontas
+// são os piores (slot 0: -9%, 11: -4%, 12: +3%) e os do meio ficam em ±4%.
+// Mais resolução não converge de forma monótona (a dinâmica é caótica), então
+// para referência de estatística use Monte Carlo. make bench mede o tempo e
+// falha se algum slot passar de MARKOV_MAX_SLOT_ERROR.
+
+typedef struct {
+    int    angleBins;     // baldes do ângulo de contato em volta do pino
+    int    velBins;       // baldes de vx e de vy
+    float  velMax;        // |v| acima disso vai para o balde da ponta
+    int    jitterPoints;  // quantos valores representam os 200 desvios possíveis
+    double minMass;       // estados com probabilidade menor que isto são descartados
+    float  dt;            // passo dos voos (GALTON_DT = física do jogo); 0 = por eventos (mais rápido, ~2,5% de variação total)
+} MarkovConfig;
+
+// Resolução padrão, pensada para o tabuleiro do jogo.
+MarkovConfig markovDefaultConfig(void);
+
+// Preenche slotProbs (board->slotCount posições, soma 1).
+// Retorna 0 em caso de sucesso, -1 se faltar memória.
+int markovSolve(const GaltonBoard *board, const MarkovConfig *config, double *slotProbs);
+
+#endif
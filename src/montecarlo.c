@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ballstore.h"
+#include "montecarlo.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define CACHE_LINE 64
+#define MAX_THREADS 256
+#define COUNTS_PER_LINE (CACHE_LINE / sizeof(unsigned long long))
+
+typedef struct {
+    const GaltonBoard  *board;
+    unsigned long long  n;
+    int                 lanes;
+    int                 events;
+    Rng                 rng;      // só lido: cada thread usa uma cópia local
+    unsigned long long *counts;   // histograma privado, começa numa linha de cache própria
+} Worker;
+
+MonteCarloConfig monteCarloDefaultConfig(void) {
+    MonteCarloConfig config;
+    config.threads = 0;
+    config.lanes = 1024;
+    config.seed = 0x5EEDULL;
+    config.events = 0;
+    return config;
+}
+
+int monteCarloCpuCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int n = (int)info.dwNumberOfProcessors;
+#else
+    int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return n > 0 ? n : 1;
+}
+
+static void *workerMain(void *arg) {
+    Worker *w = (Worker *)arg;
+    // O gerador muda a cada sorteio; uma cópia na pilha evita que threads
+    // vizinhas disputem a linha de cache onde os Workers ficam juntos
+    Rng rng = w->rng;
+    if (w->events) {
+        galtonDropBallsEvents(w->board, (long long)w->n, &rng, w->counts);
+    } else {
+        ballStoreDropBalls(w->board, (long long)w->n, w->lanes, GALTON_DT, &rng, w->counts);
+    }
+    return NULL;
+}
+
+int monteCarloRun(const GaltonBoard *board, unsigned long long n, const MonteCarloConfig *config, unsigned long long *slotCounts) {
+    MonteCarloConfig defaults = monteCarloDefaultConfig();
+    if (!config) config = &defaults;
+
+    int threads = config->threads > 0 ? config->threads : monteCarloCpuCount();
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if ((unsigned long long)threads > n) threads = n > 0 ? (int)n : 1;
+
+    // Um bloco só com todos os histogramas; cada um ocupa linhas de cache
+    // inteiras para que as threads nunca escrevam na mesma linha.
+    size_t stride = (board->slotCount + COUNTS_PER_LINE - 1) / COUNTS_PER_LINE * COUNTS_PER_LINE;
+    void *raw = calloc(threads * stride + COUNTS_PER_LINE, sizeof(unsigned long long));
+    Worker *workers = calloc(threads, sizeof(Worker));
+    pthread_t *ids = calloc(threads, sizeof(pthread_t));
+    if (!raw || !workers || !ids) {
+        free(raw); free(workers); free(ids);
+        return -1;
+    }
+    unsigned long long *counts = (unsigned long long *)(((uintptr_t)raw + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1));
+
+    // Divide as bolas; as primeiras threads levam o resto da divisão
+    Rng seeder;
+    rngSeed(&seeder, config->seed);
+    for (int t = 0; t < threads; t++) {
+        workers[t].board  = board;
+        workers[t].n      = n / threads + ((unsigned long long)t < n % threads ? 1 : 0);
+        workers[t].lanes  = config->lanes > 0 ? config->lanes : 1;
+        workers[t].events = config->events;
+        workers[t].counts = counts + t * stride;
+        rngSplit(&seeder, &workers[t].rng);
+    }
+
+    // A thread chamadora também trabalha: roda o worker 0
+    int started = 1;
+    int result = 0;
+    for (int t = 1; t < threads; t++, started++) {
+        if (pthread_create(&ids[t], NULL, workerMain, &workers[t]) != 0) {
+            result = -1;
+            break;
+        }
+    }
+    if (result == 0) workerMain(&workers[0]);
+    for (int t = 1; t < started; t++) pthread_join(ids[t], NULL);
+
+    if (result == 0) {
+        for (int t = 0; t < threads; t++) {
+            for (int i = 0; i < board->slotCount; i++) slotCounts[i] += workers[t].counts[i];
+        }
+    }
+
+    free(raw);
+    free(workers);
+    free(ids);
+    return result;
+}
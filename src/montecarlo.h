@@ -0,0 +1,29 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include "galton.h"
+
+// Simulação de Monte Carlo em várias threads: cada thread solta a sua parte
+// das bolas com o próprio gerador e o próprio histograma (contadores de
+// 64 bits), e os histogramas só são somados no final.
+
+typedef struct {
+    int threads;                // 0 = um por núcleo
+    int lanes;                  // bolas caindo juntas em cada thread (BallStore)
+    unsigned long long seed;    // cada thread recebe um fluxo (rngSplit) desta semente
+    int events;                 // 1 = modo por eventos (galtonDropBallsEvents) em vez do passo fixo
+} MonteCarloConfig;
+
+// Configuração padrão: todos os núcleos, 1024 bolas por thread, semente fixa,
+// passo fixo (mesma física do jogo).
+MonteCarloConfig monteCarloDefaultConfig(void);
+
+// Número de núcleos lógicos da máquina (no mínimo 1).
+int monteCarloCpuCount(void);
+
+// Solta 'n' bolas no tabuleiro e soma o slot de cada uma em slotCounts
+// (board->slotCount posições; o vetor NÃO é zerado aqui).
+// Retorna 0 em caso de sucesso, -1 se não conseguiu memória ou threads.
+int monteCarloRun(const GaltonBoard *board, unsigned long long n, const MonteCarloConfig *config, unsigned long long *slotCounts);
+
+#endif
@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include <string.h>
+#include "binomial.h"
+#include "prediction.h"
+
+int predictionInit(Prediction *pred, int slotCount) {
+    memset(pred, 0, sizeof(*pred));
+    pred->slotCount = slotCount;
+    pred->slotProbs = calloc(slotCount, sizeof(double));
+    return pred->slotProbs ? 0 : -1;
+}
+
+void predictionFree(Prediction *pred) {
+    free(pred->slotProbs);
+    pred->slotProbs = NULL;
+    pred->valid = 0;
+}
+
+void predictionInvalidate(Prediction *pred) {
+    pred->valid = 0;
+}
+
+int predictionUpdate(Prediction *pred, int nRemaining, int centerSlot) {
+    if (pred->valid && pred->nRemaining == nRemaining && pred->centerSlot == centerSlot) return 0;
+
+    memset(pred->slotProbs, 0, sizeof(double) * pred->slotCount);
+    const double *pmf = binomialPmf(nRemaining);
+    if (!pmf) {
+        pred->valid = 0;
+        return 1;
+    }
+    // O pico da binomial (k = n/2) fica no slot central; o que sai do
+    // tabuleiro não é desenhado
+    int slotOffset = centerSlot - nRemaining / 2;
+    for (int k = 0; k <= nRemaining; k++) {
+        int slot = k + slotOffset;
+        if (slot >= 0 && slot < pred->slotCount) pred->slotProbs[slot] = pmf[k];
+    }
+    pred->nRemaining = nRemaining;
+    pred->centerSlot = centerSlot;
+    pred->valid = 1;
+    pred->rebuilds++;
+    return 1;
+}
+
+int predictionUpdateForBall(Prediction *pred, const GaltonBoard *board, const Ball *ball) {
+    float progress = (ball->y - board->firstPinY) / (board->baseY - board->firstPinY);
+    if (progress < 0.0f) progress = 0.0f;
+    if (progress > 1.0f) progress = 1.0f;
+    int nRemaining = (int)((1.0f - progress) * board->numPinsY);
+    if (nRemaining < 1) nRemaining = 1;
+    int centerSlot = (int)((ball->x - board->firstSlotX) / board->slotWidth);
+    return predictionUpdate(pred, nRemaining, centerSlot);
+}
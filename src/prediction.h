@@ -0,0 +1,32 @@
+#ifndef PREDICTION_H
+#define PREDICTION_H
+
+#include "galton.h"
+
+// Previsão dinâmica (barras verdes): binomial das fileiras que faltam,
+// centrada no slot abaixo da bola. Só muda quando a chave
+// (fileiras restantes, slot central) muda, então fica guardada e só é
+// recalculada nessas horas; nos outros frames o desenho só lê slotProbs.
+
+typedef struct {
+    int     slotCount;
+    int     nRemaining;   // chave do cache
+    int     centerSlot;
+    int     valid;
+    double *slotProbs;    // probabilidade prevista por slot
+    unsigned long long rebuilds;
+} Prediction;
+
+// Retorna 0 em caso de sucesso, -1 se faltar memória.
+int  predictionInit(Prediction *pred, int slotCount);
+void predictionFree(Prediction *pred);
+void predictionInvalidate(Prediction *pred);
+
+// Recalcula só se (nRemaining, centerSlot) mudou. Retorna 1 se recalculou.
+int  predictionUpdate(Prediction *pred, int nRemaining, int centerSlot);
+
+// Calcula a chave a partir da posição da bola no tabuleiro e chama
+// predictionUpdate().
+int  predictionUpdateForBall(Prediction *pred, const GaltonBoard *board, const Ball *ball);
+
+#endif
@@ -0,0 +1,125 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include "profiler.h"
+#include "trace.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+const char *profilerPhaseNames[PROF_PHASE_COUNT] = {
+    "frame", "update", "fisica", "graficos", "previsao", "interface", "apresentacao"
+};
+
+const char *profilerCounterNames[PROF_COUNTER_COUNT] = {
+    "pinos testados", "bolas ativas", "itens desenhados"
+};
+
+void profilerInit(Profiler *prof, double budgetMs) {
+    memset(prof, 0, sizeof(*prof));
+    prof->budgetMs = budgetMs;
+}
+
+double profilerNow(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Cada fase também vira uma zona do trace.c (quando ele está gravando)
+void profilerBegin(Profiler *prof, ProfilerPhase phase) {
+    traceBegin(profilerPhaseNames[phase]);
+    prof->open[phase] = profilerNow();
+}
+
+void profilerEnd(Profiler *prof, ProfilerPhase phase) {
+    prof->current[phase] += (profilerNow() - prof->open[phase]) * 1000.0;
+    traceEnd(profilerPhaseNames[phase]);
+}
+
+void profilerCount(Profiler *prof, ProfilerCounter counter, long long n) {
+    prof->currentCounters[counter] += n;
+}
+
+void profilerAddTime(Profiler *prof, ProfilerPhase phase, double ms) {
+    prof->current[phase] += ms;
+}
+
+void profilerEndFrame(Profiler *prof) {
+    for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+        prof->ms[p][prof->head] = prof->current[p];
+        prof->current[p] = 0.0;
+    }
+    for (int c = 0; c < PROF_COUNTER_COUNT; c++) {
+        traceCounter(profilerCounterNames[c], prof->currentCounters[c]);
+        prof->counters[c][prof->head] = prof->currentCounters[c];
+        prof->currentCounters[c] = 0;
+    }
+    prof->head = (prof->head + 1) % PROFILER_FRAMES;
+    if (prof->filled < PROFILER_FRAMES) prof->filled++;
+}
+
+void profilerDiscardFrame(Profiler *prof) {
+    memset(prof->current, 0, sizeof(prof->current));
+    memset(prof->currentCounters, 0, sizeof(prof->currentCounters));
+}
+
+static int compareDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// A ordem do anel não importa para as estatísticas: as posições válidas
+// são sempre 0..filled-1 (o anel só dá a volta depois de cheio)
+double profilerPercentile(const Profiler *prof, ProfilerPhase phase, double p) {
+    if (prof->filled == 0) return 0.0;
+    double sorted[PROFILER_FRAMES];
+    memcpy(sorted, prof->ms[phase], sizeof(double) * prof->filled);
+    qsort(sorted, prof->filled, sizeof(double), compareDouble);
+    // Posto mais próximo
+    int rank = (int)(p / 100.0 * prof->filled + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > prof->filled) rank = prof->filled;
+    return sorted[rank - 1];
+}
+
+double profilerMax(const Profiler *prof, ProfilerPhase phase) {
+    double max = 0.0;
+    for (int i = 0; i < prof->filled; i++) {
+        if (prof->ms[phase][i] > max) max = prof->ms[phase][i];
+    }
+    return max;
+}
+
+int profilerSpikes(const Profiler *prof) {
+    int spikes = 0;
+    for (int i = 0; i < prof->filled; i++) {
+        if (prof->ms[PROF_FRAME][i] > prof->budgetMs) spikes++;
+    }
+    return spikes;
+}
+
+double profilerCounterMean(const Profiler *prof, ProfilerCounter counter) {
+    if (prof->filled == 0) return 0.0;
+    long long sum = 0;
+    for (int i = 0; i < prof->filled; i++) sum += prof->counters[counter][i];
+    return (double)sum / prof->filled;
+}
+
+long long profilerCounterLast(const Profiler *prof, ProfilerCounter counter) {
+    if (prof->filled == 0) return 0;
+    return prof->counters[counter][(prof->head + PROFILER_FRAMES - 1) % PROFILER_FRAMES];
+}
@@ -0,0 +1,72 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Perfil do frame por fase. Cada fase é medida com profilerBegin/End (pode
+// abrir e fechar várias vezes no mesmo frame, o tempo soma) e
+// profilerEndFrame() guarda o frame num anel com os últimos
+// PROFILER_FRAMES frames, de onde saem os percentis do painel.
+// Sem raylib: o relógio é o contador de alta resolução do sistema.
+
+#define PROFILER_FRAMES 240     // ~4 s a 60 FPS
+
+typedef enum {
+    PROF_FRAME,         // frame inteiro, do começo do loop até a volta do EndDrawing
+    PROF_UPDATE,        // switch de estados
+    PROF_PHYSICS,       // passos da física (thread do sim.c, somado por frame)
+    PROF_GRAPHS,        // BLOCO 4
+    PROF_PREDICTION,    // BLOCO 5
+    PROF_UI,            // BLOCO D
+    PROF_PRESENT,       // EndDrawing: envio do lote, troca de buffer e vsync
+    PROF_PHASE_COUNT
+} ProfilerPhase;
+
+typedef enum {
+    PROF_PIN_TESTS,     // pinos testados contra as bolas (jogo, chuva e rollout)
+    PROF_BALLS,         // bolas ativas
+    PROF_DRAW_ITEMS,    // itens entregues ao raylib: cada retângulo, textura, letra ou bola conta 1
+    PROF_COUNTER_COUNT
+} ProfilerCounter;
+
+typedef struct {
+    double    ms[PROF_PHASE_COUNT][PROFILER_FRAMES];
+    long long counters[PROF_COUNTER_COUNT][PROFILER_FRAMES];
+    double    open[PROF_PHASE_COUNT];       // início da medição em andamento
+    double    current[PROF_PHASE_COUNT];    // acumulado no frame atual (ms)
+    long long currentCounters[PROF_COUNTER_COUNT];
+    int       head;       // próxima posição do anel
+    int       filled;     // frames válidos no anel
+    double    budgetMs;   // frames acima disso contam como pico
+} Profiler;
+
+extern const char *profilerPhaseNames[PROF_PHASE_COUNT];
+extern const char *profilerCounterNames[PROF_COUNTER_COUNT];
+
+void   profilerInit(Profiler *prof, double budgetMs);
+
+// Segundos num relógio monotônico (a origem não importa).
+double profilerNow(void);
+
+void   profilerBegin(Profiler *prof, ProfilerPhase phase);
+void   profilerEnd(Profiler *prof, ProfilerPhase phase);
+void   profilerCount(Profiler *prof, ProfilerCounter counter, long long n);
+
+// Soma à fase um tempo medido em outro lugar (ex.: em outra thread).
+void   profilerAddTime(Profiler *prof, ProfilerPhase phase, double ms);
+
+// Fecha o frame: guarda fases e contadores no anel e zera o acumulado.
+void   profilerEndFrame(Profiler *prof);
+// Zera o acumulado sem guardar (frame que não deve entrar nos percentis).
+void   profilerDiscardFrame(Profiler *prof);
+
+// Percentil p (0..100) da fase nos frames do anel, em ms.
+double profilerPercentile(const Profiler *prof, ProfilerPhase phase, double p);
+double profilerMax(const Profiler *prof, ProfilerPhase phase);
+
+// Frames do anel cujo PROF_FRAME passou de budgetMs.
+int    profilerSpikes(const Profiler *prof);
+
+// Média e último valor do contador nos frames do anel.
+double    profilerCounterMean(const Profiler *prof, ProfilerCounter counter);
+long long profilerCounterLast(const Profiler *prof, ProfilerCounter counter);
+
+#endif
@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include "rain.h"
+
+// Posição livre: inativa e sem slot. Bola que acabou de aterrissar: inativa
+// e com o slot preenchido pelo kernel (ainda não devolvida).
+#define FREE_SLOT -1
+
+int rainInit(RainEmitter *rain, int capacity, int target, float rate) {
+    rain->freeCount = 0;
+    rain->live = 0;
+    rain->target = target < capacity ? target : capacity;
+    rain->rate = rate;
+    rain->credit = 0.0f;
+    rain->emitting = 0;
+    if (ballStoreInit(&rain->store, capacity) != 0) return -1;
+    rain->freeList = malloc(sizeof(int) * rain->store.capacity);
+    if (!rain->freeList) {
+        ballStoreFree(&rain->store);
+        return -1;
+    }
+    return 0;
+}
+
+void rainFree(RainEmitter *rain) {
+    ballStoreFree(&rain->store);
+    free(rain->freeList);
+    rain->freeList = NULL;
+}
+
+void rainSetEmitting(RainEmitter *rain, int emitting) {
+    rain->emitting = emitting;
+    if (!emitting) rain->credit = 0.0f;
+}
+
+int rainSpawn(RainEmitter *rain, const GaltonBoard *board) {
+    int i;
+    if (rain->freeCount > 0) i = rain->freeList[--rain->freeCount];
+    else if (rain->store.count < rain->store.capacity) i = rain->store.count++;
+    else return -1;
+
+    Ball ball;
+    galtonSpawnBall(board, &ball);
+    ballStoreSet(&rain->store, i, &ball);
+    rain->live++;
+    return i;
+}
+
+void rainRetire(RainEmitter *rain, int index) {
+    rain->store.active[index] = 0;
+    rain->store.slotIndex[index] = FREE_SLOT;
+    rain->freeList[rain->freeCount++] = index;
+    rain->live--;
+}
+
+int rainStep(RainEmitter *rain, const GaltonBoard *board, float dt, Rng *rng, int *landedSlots) {
+    if (rain->emitting) {
+        rain->credit += rain->rate * dt;
+        while (rain->credit >= 1.0f && rain->live < rain->target && rainSpawn(rain, board) >= 0) rain->credit -= 1.0f;
+        // Não acumula lançamentos enquanto o alvo está cheio
+        if (rain->credit > 1.0f) rain->credit = 1.0f;
+    }
+    if (rain->live == 0) return 0;
+
+    int landed = ballStoreStep(&rain->store, board, dt, rng, NULL);
+    if (landed == 0) return 0;
+
+    // Quem aterrissou neste passo: inativa e com slot preenchido
+    int n = 0;
+    for (int i = 0; i < rain->store.count && n < landed; i++) {
+        if (rain->store.active[i] || rain->store.slotIndex[i] == FREE_SLOT) continue;
+        landedSlots[n++] = rain->store.slotIndex[i];
+        rainRetire(rain, i);
+    }
+    return n;
+}
+
+int rainPositions(const RainEmitter *rain, float *x, float *y, int max) {
+    int n = 0;
+    for (int i = 0; i < rain->store.count && n < max; i++) {
+        if (!rain->store.active[i]) continue;
+        x[n] = rain->store.x[i];
+        y[n] = rain->store.y[i];
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,46 @@
+#ifndef RAIN_H
+#define RAIN_H
+
+#include "ballstore.h"
+
+// Modo "chuva" (máquina de Galton de verdade): um emissor que mantém
+// milhares de bolas caindo ao mesmo tempo, todas no BallStore (SIMD).
+// As posições do BallStore são reaproveitadas por uma lista livre: bola
+// que aterrissa devolve a posição, bola nova pega a última devolvida, e
+// só quando a lista está vazia o BallStore cresce (até a capacidade).
+// Nada é alocado depois de rainInit().
+
+typedef struct {
+    BallStore store;
+    int      *freeList;      // posições livres abaixo de store.count (pilha)
+    int       freeCount;
+    int       live;          // bolas caindo
+    int       target;        // quantas manter caindo enquanto emite
+    float     rate;          // lançamentos por segundo, no máximo
+    float     credit;        // lançamentos acumulados e ainda não feitos
+    int       emitting;
+} RainEmitter;
+
+// Retorna 0 em caso de sucesso, -1 se faltar memória.
+int  rainInit(RainEmitter *rain, int capacity, int target, float rate);
+void rainFree(RainEmitter *rain);
+
+// Liga/desliga o emissor. Desligado, as bolas que já estão caindo continuam.
+void rainSetEmitting(RainEmitter *rain, int emitting);
+
+// Pega uma posição do pool e coloca uma bola no ponto de lançamento.
+// Retorna o índice ou -1 se o pool está cheio.
+int  rainSpawn(RainEmitter *rain, const GaltonBoard *board);
+
+// Devolve a posição ao pool.
+void rainRetire(RainEmitter *rain, int index);
+
+// Lança o que o emissor permitir e avança todas as bolas 'dt' segundos.
+// As que aterrissaram voltam ao pool e o slot de cada uma vai para
+// landedSlots (até store.capacity posições). Retorna quantas aterrissaram.
+int  rainStep(RainEmitter *rain, const GaltonBoard *board, float dt, Rng *rng, int *landedSlots);
+
+// Copia as posições das bolas caindo para x/y (até 'max'). Retorna quantas.
+int  rainPositions(const RainEmitter *rain, float *x, float *y, int max);
+
+#endif
@@ -0,0 +1,85 @@
+#include "rng.h"
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void rngSeed(Rng *rng, uint64_t seed) {
+    // splitmix64 espalha a semente e nunca deixa o estado todo zerado
+    for (int i = 0; i < 4; i++) rng->s[i] = splitmix64(&seed);
+}
+
+uint64_t rngNext(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+// Método de Lemire: multiplica em vez de tirar resto e só rejeita na
+// faixa pequena que causaria viés.
+uint32_t rngBounded(Rng *rng, uint32_t bound) {
+    uint64_t m = (uint64_t)(uint32_t)(rngNext(rng) >> 32) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = (uint32_t)(-bound) % bound;
+        while (low < threshold) {
+            m = (uint64_t)(uint32_t)(rngNext(rng) >> 32) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+float rngFloat(Rng *rng) {
+    return (rngNext(rng) >> 40) * (1.0f / 16777216.0f);
+}
+
+void rngJump(Rng *rng) {
+    static const uint64_t JUMP[] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (1ULL << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rngNext(rng);
+        }
+    }
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+void rngSplit(Rng *parent, Rng *child) {
+    *child = *parent;
+    rngJump(parent);
+}
+
+void rngFillBounded(Rng *rng, uint32_t *out, int n, uint32_t bound) {
+    // Copia o estado para variáveis locais para o compilador manter tudo
+    // em registradores durante o laço.
+    Rng local = *rng;
+    for (int i = 0; i < n; i++) out[i] = rngBounded(&local, bound);
+    *rng = local;
+}
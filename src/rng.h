@@ -0,0 +1,37 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Gerador pseudoaleatório xoshiro256** (Blackman & Vigna).
+// Rápido, sem estado global e reproduzível a partir da semente. rngJump()
+// avança 2^128 números, o que dá fluxos independentes para cada thread
+// ou bola a partir de um único gerador.
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+// Inicializa o estado a partir de uma semente de 64 bits (via splitmix64).
+void     rngSeed(Rng *rng, uint64_t seed);
+
+uint64_t rngNext(Rng *rng);
+
+// Inteiro uniforme em [0, bound), sem o viés do "rand() % bound".
+uint32_t rngBounded(Rng *rng, uint32_t bound);
+
+// Float uniforme em [0, 1).
+float    rngFloat(Rng *rng);
+
+// Avança o gerador 2^128 passos.
+void     rngJump(Rng *rng);
+
+// Copia 'parent' para 'child' e pula 'parent' para a frente, de forma que
+// os dois fluxos nunca se sobreponham. Chamado em sequência, gera um fluxo
+// independente por thread.
+void     rngSplit(Rng *parent, Rng *child);
+
+// Preenche out[0..n-1] com inteiros uniformes em [0, bound).
+void     rngFillBounded(Rng *rng, uint32_t *out, int n, uint32_t bound);
+
+#endif
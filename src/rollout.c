@@ -0,0 +1,171 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ballstore.h"
+#include "rollout.h"
+#include "trace.h"
+
+typedef struct {
+    RolloutPredictor *pred;
+    Rng rng;
+} WorkerArgs;
+
+// Um lote: ROLLOUT_BATCH cópias da bola caindo juntas no BallStore (SIMD),
+// cada uma com os próprios desvios, somadas em counts ao aterrissar
+static void runBatch(const GaltonBoard *board, BallStore *store, const Ball *ball, Rng *rng, unsigned long long *counts) {
+    ballStoreClear(store);
+    for (int i = 0; i < ROLLOUT_BATCH; i++) ballStoreAdd(store, ball);
+    int landed = 0;
+    for (int step = 0; step < GALTON_MAX_STEPS && landed < ROLLOUT_BATCH; step++) {
+        landed += ballStoreStep(store, board, GALTON_DT, rng, counts);
+    }
+    // Trava de segurança: quem não caiu conta no slot em que está
+    for (int i = 0; i < store->count; i++) {
+        if (store->active[i]) counts[galtonSlotFromX(board, store->x[i])]++;
+    }
+}
+
+// O histograma começado em 'anchor' ainda vale para 'ball'?
+static int closeEnough(const Ball *anchor, const Ball *ball) {
+    return fabsf(ball->x - anchor->x) <= ROLLOUT_REUSE_DIST &&
+           fabsf(ball->y - anchor->y) <= ROLLOUT_REUSE_DIST &&
+           fabsf(ball->vx - anchor->vx) <= ROLLOUT_REUSE_SPEED &&
+           fabsf(ball->vy - anchor->vy) <= ROLLOUT_REUSE_SPEED;
+}
+
+static void *rolloutMain(void *arg) {
+    WorkerArgs *args = (WorkerArgs *)arg;
+    RolloutPredictor *pred = args->pred;
+    Rng rng = args->rng;
+    free(args);
+    traceThreadName("rollout");
+
+    int slotCount = pred->board->slotCount;
+    unsigned long long *counts = calloc(slotCount, sizeof(unsigned long long));
+    double *probs = calloc(slotCount, sizeof(double));
+    BallStore store;
+    int storeOk = ballStoreInit(&store, ROLLOUT_BATCH) == 0;
+    unsigned long current = 0;
+    unsigned long samples = ROLLOUT_MAX;   // nada a simular até o primeiro pedido
+    Ball ball = {0}, anchor = {0};         // estado mais novo / estado que começou counts
+    int anchored = 0;
+
+    pthread_mutex_lock(&pred->lock);
+    for (;;) {
+        // Dorme até chegar um estado novo (ou o pedido para parar)
+        while (!pred->stop && (pred->requestId == current && samples >= ROLLOUT_MAX))
+            pthread_cond_wait(&pred->wake, &pred->lock);
+        if (pred->stop || !counts || !probs || !storeOk) break;
+        if (pred->requestId != current) {
+            current = pred->requestId;
+            ball = pred->request;
+            if (!anchored || !closeEnough(&anchor, &ball)) {
+                anchor = ball;
+                anchored = 1;
+                samples = 0;
+                memset(counts, 0, sizeof(unsigned long long) * slotCount);
+            }
+            // Histograma cheio e a bola quase no mesmo lugar: só avisa que
+            // o resultado vale para o pedido novo
+            if (samples >= ROLLOUT_MAX) {
+                pred->publishedId = current;
+                continue;
+            }
+        }
+        pthread_mutex_unlock(&pred->lock);
+
+        // Lote fora do lock: o jogo pode pedir outro estado enquanto isso
+        traceBegin("rollout lote");
+        runBatch(pred->board, &store, &ball, &rng, counts);
+        traceEnd("rollout lote");
+        samples += ROLLOUT_BATCH;
+        for (int i = 0; i < slotCount; i++) probs[i] = (double)counts[i] / samples;
+
+        pthread_mutex_lock(&pred->lock);
+        memcpy(pred->published, probs, sizeof(double) * slotCount);
+        pred->publishedId = current;
+        pred->publishedSamples = samples;
+        pred->publishSerial++;
+        pred->pinTests = store.pinTests;
+    }
+    pthread_mutex_unlock(&pred->lock);
+
+    if (storeOk) ballStoreFree(&store);
+    free(counts);
+    free(probs);
+    return NULL;
+}
+
+int rolloutInit(RolloutPredictor *pred, const GaltonBoard *board, unsigned long long seed) {
+    memset(pred, 0, sizeof(*pred));
+    pred->board = board;
+    pred->published = calloc(board->slotCount, sizeof(double));
+    WorkerArgs *args = malloc(sizeof(WorkerArgs));
+    if (!pred->published || !args) {
+        free(pred->published);
+        free(args);
+        pred->published = NULL;
+        return -1;
+    }
+    args->pred = pred;
+    rngSeed(&args->rng, seed);
+
+    pthread_mutex_init(&pred->lock, NULL);
+    pthread_cond_init(&pred->wake, NULL);
+    // Sem pedido ainda: a thread começa dormindo
+    if (pthread_create(&pred->thread, NULL, rolloutMain, args) != 0) {
+        pthread_cond_destroy(&pred->wake);
+        pthread_mutex_destroy(&pred->lock);
+        free(pred->published);
+        free(args);
+        pred->published = NULL;
+        return -1;
+    }
+    pred->running = 1;
+    return 0;
+}
+
+void rolloutFree(RolloutPredictor *pred) {
+    if (!pred->running) return;
+    pthread_mutex_lock(&pred->lock);
+    pred->stop = 1;
+    pthread_cond_signal(&pred->wake);
+    pthread_mutex_unlock(&pred->lock);
+    pthread_join(pred->thread, NULL);
+
+    pthread_cond_destroy(&pred->wake);
+    pthread_mutex_destroy(&pred->lock);
+    free(pred->published);
+    pred->published = NULL;
+    pred->running = 0;
+}
+
+unsigned long rolloutSubmit(RolloutPredictor *pred, const Ball *ball) {
+    pthread_mutex_lock(&pred->lock);
+    pred->request = *ball;
+    unsigned long id = ++pred->requestId;
+    pthread_cond_signal(&pred->wake);
+    pthread_mutex_unlock(&pred->lock);
+    return id;
+}
+
+int rolloutPoll(RolloutPredictor *pred, unsigned long firstId, unsigned long *serial, double *slotProbs) {
+    int copied = 0;
+    pthread_mutex_lock(&pred->lock);
+    if (pred->publishedId >= firstId && pred->publishSerial != *serial) {
+        memcpy(slotProbs, pred->published, sizeof(double) * pred->board->slotCount);
+        *serial = pred->publishSerial;
+        copied = 1;
+    }
+    pthread_mutex_unlock(&pred->lock);
+    return copied;
+}
+
+long long rolloutPinTests(RolloutPredictor *pred) {
+    pthread_mutex_lock(&pred->lock);
+    long long tests = pred->pinTests;
+    pthread_mutex_unlock(&pred->lock);
+    return tests;
+}
@@ -0,0 +1,63 @@
+#ifndef ROLLOUT_H
+#define ROLLOUT_H
+
+#include <pthread.h>
+#include "galton.h"
+
+// Previsão por simulação da bola que está caindo: uma thread de fundo
+// recebe o estado atual da bola (posição e velocidade) e roda milhares de
+// continuações com a física do jogo (kernels do BallStore, em lotes), cada
+// uma com os próprios desvios, até a base. A cada lote o histograma
+// normalizado é publicado; o desenho só copia o último resultado, sem
+// esperar a thread.
+//
+// Enquanto a bola anda pouco (ROLLOUT_REUSE_DIST / ROLLOUT_REUSE_SPEED) os
+// lotes seguem do estado mais novo e somam no mesmo histograma; um estado
+// longe do que começou o histograma (ex.: depois de bater num pino) o
+// descarta.
+
+#define ROLLOUT_BATCH 256       // continuações entre duas publicações
+#define ROLLOUT_MAX   8192      // para de simular o mesmo estado depois disso
+#define ROLLOUT_REUSE_DIST  PIN_RADIUS   // px
+#define ROLLOUT_REUSE_SPEED 30.0f        // px/s
+
+typedef struct {
+    const GaltonBoard *board;
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    int             running;
+
+    // Pedido (escrito pelo jogo, sob lock)
+    Ball          request;
+    unsigned long requestId;   // muda a cada rolloutSubmit()
+    int           stop;
+
+    // Resultado (escrito pela thread, sob lock)
+    double       *published;   // board->slotCount probabilidades
+    unsigned long publishedId; // pedido a que o resultado se refere (0 = nenhum)
+    unsigned long publishedSamples;
+    unsigned long publishSerial; // muda a cada publicação
+    long long     pinTests;      // pinos testados pelos lotes (acumulado)
+} RolloutPredictor;
+
+// Inicia a thread. Retorna 0 em caso de sucesso, -1 se faltar memória ou
+// não conseguir criar a thread.
+int  rolloutInit(RolloutPredictor *pred, const GaltonBoard *board, unsigned long long seed);
+
+// Para a thread e libera a memória.
+void rolloutFree(RolloutPredictor *pred);
+
+// Entrega o estado atual da bola. Retorna o id do pedido (crescente).
+unsigned long rolloutSubmit(RolloutPredictor *pred, const Ball *ball);
+
+// Copia o resultado mais recente para slotProbs se ele for de 'firstId'
+// ou mais novo (ex.: o primeiro pedido da queda atual; não precisa ser o
+// último pedido) e se mudou desde 'serial' (atualizado aqui). Retorna 1 se
+// copiou, 0 caso contrário. Não bloqueia além da cópia.
+int  rolloutPoll(RolloutPredictor *pred, unsigned long firstId, unsigned long *serial, double *slotProbs);
+
+// Pinos testados por todas as continuações até agora (para o profiler).
+long long rolloutPinTests(RolloutPredictor *pred);
+
+#endif
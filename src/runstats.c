@@ -0,0 +1,133 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "runstats.h"
+
+static void kahanAdd(KahanSum *k, double value) {
+    double y = value - k->carry;
+    double t = k->sum + y;
+    k->carry = (t - k->sum) - y;
+    k->sum = t;
+}
+
+// Slot possível mais próximo de 'slot' (o de menor índice no empate),
+// ou -1 se nenhum for
+static int nearestPossible(const double *expected, int slotCount, int slot) {
+    for (int d = 0; d < slotCount; d++) {
+        if (slot - d >= 0 && expected[slot - d] > RUNSTATS_MIN_PROB) return slot - d;
+        if (slot + d < slotCount && expected[slot + d] > RUNSTATS_MIN_PROB) return slot + d;
+    }
+    return -1;
+}
+
+int runStatsInit(RunStats *stats, int slotCount, const double *expected) {
+    memset(stats, 0, sizeof(*stats));
+    stats->slotCount = slotCount;
+    stats->binOf = malloc(sizeof(int) * slotCount);
+    stats->counts = calloc(slotCount, sizeof(unsigned long long));
+    stats->expected = calloc(slotCount, sizeof(double));
+    stats->logExpected = malloc(sizeof(double) * slotCount);
+    if (!stats->binOf || !stats->counts || !stats->expected || !stats->logExpected) {
+        runStatsFree(stats);
+        return -1;
+    }
+
+    // Cada slot possível vira um grupo, em ordem; os impossíveis vão para o
+    // grupo do vizinho. Sem nenhum possível fica um grupo só.
+    for (int i = 0; i < slotCount; i++) {
+        stats->binOf[i] = expected[i] > RUNSTATS_MIN_PROB ? stats->binCount++ : -1;
+    }
+    for (int i = 0; i < slotCount; i++) {
+        if (stats->binOf[i] >= 0) continue;
+        int near = nearestPossible(expected, slotCount, i);
+        stats->binOf[i] = near >= 0 ? stats->binOf[near] : 0;
+    }
+    if (stats->binCount == 0) stats->binCount = 1;
+
+    double total = 0.0;
+    for (int i = 0; i < slotCount; i++) {
+        if (expected[i] > RUNSTATS_MIN_PROB) {
+            stats->expected[stats->binOf[i]] += expected[i];
+            total += expected[i];
+        }
+    }
+    for (int b = 0; b < stats->binCount; b++) {
+        stats->expected[b] = total > 0.0 ? stats->expected[b] / total : 1.0;
+        stats->logExpected[b] = log(stats->expected[b]);
+    }
+    return 0;
+}
+
+void runStatsFree(RunStats *stats) {
+    free(stats->binOf);
+    free(stats->counts);
+    free(stats->expected);
+    free(stats->logExpected);
+    stats->binOf = NULL;
+    stats->counts = NULL;
+    stats->expected = NULL;
+    stats->logExpected = NULL;
+}
+
+void runStatsReset(RunStats *stats) {
+    memset(stats->counts, 0, sizeof(unsigned long long) * stats->binCount);
+    stats->n = 0;
+    stats->mean = stats->m2 = stats->m3 = 0.0;
+    memset(&stats->chiNum, 0, sizeof(KahanSum));
+    memset(&stats->countLogCount, 0, sizeof(KahanSum));
+    memset(&stats->countLogExpected, 0, sizeof(KahanSum));
+}
+
+void runStatsAdd(RunStats *stats, int slot) {
+    if (slot < 0 || slot >= stats->slotCount) return;
+    int bin = stats->binOf[slot];
+    double n0 = (double)stats->n;
+    double c = (double)stats->counts[bin];
+    double p = stats->expected[bin];
+
+    // Qui-quadrado: com e_i = c_i - n p_i, somar uma bola no grupo j leva
+    // sum(e_i² / p_i) a sum + (2 e_j + 1) / p_j - 1 (os outros grupos entram
+    // pelo termo -1, porque sum(e_i) = 0 e sum(p_i) = 1)
+    double e = c - n0 * p;
+    kahanAdd(&stats->chiNum, (2.0 * e + 1.0) / p - 1.0);
+
+    // KL: (c+1) ln(c+1) - c ln c, escrito de forma estável
+    kahanAdd(&stats->countLogCount, c > 0.0 ? c * log1p(1.0 / c) + log(c + 1.0) : 0.0);
+    kahanAdd(&stats->countLogExpected, stats->logExpected[bin]);
+
+    // Média, M2 e M3 (Welford, com o termo de terceira ordem de Terriberry)
+    double n1 = n0 + 1.0;
+    double delta = slot - stats->mean;
+    double deltaN = delta / n1;
+    double term = delta * deltaN * n0;
+    stats->mean += deltaN;
+    stats->m3 += term * deltaN * (n1 - 2.0) - 3.0 * deltaN * stats->m2;
+    stats->m2 += term;
+
+    stats->counts[bin]++;
+    stats->n++;
+}
+
+double runStatsMean(const RunStats *stats) {
+    return stats->mean;
+}
+
+double runStatsVariance(const RunStats *stats) {
+    return stats->n > 1 ? stats->m2 / (double)(stats->n - 1) : 0.0;
+}
+
+double runStatsSkewness(const RunStats *stats) {
+    if (stats->n < 2 || stats->m2 <= 0.0) return 0.0;
+    return sqrt((double)stats->n) * stats->m3 / pow(stats->m2, 1.5);
+}
+
+double runStatsChiSquare(const RunStats *stats) {
+    return stats->n > 0 ? stats->chiNum.sum / (double)stats->n : 0.0;
+}
+
+double runStatsKl(const RunStats *stats) {
+    if (stats->n == 0) return 0.0;
+    double n = (double)stats->n;
+    double kl = (stats->countLogCount.sum - stats->countLogExpected.sum) / n - log(n);
+    return kl > 0.0 ? kl : 0.0;
+}
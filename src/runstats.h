@@ -0,0 +1,53 @@
+#ifndef RUNSTATS_H
+#define RUNSTATS_H
+
+// Estatísticas das aterrissagens atualizadas em O(1) por bola, sem varrer
+// o histograma: média e variância (Welford), assimetria, qui-quadrado e
+// divergência KL contra uma distribuição esperada (ex.: a binomial).
+// Os contadores são de 64 bits e as somas longas usam soma compensada
+// (Kahan), então os valores continuam certos com 10^9 bolas ou mais.
+//
+// Slots "impossíveis" no modelo (na binomial, os das pontas) entram no
+// qui-quadrado e no KL junto com o vizinho possível mais próximo; com uma
+// probabilidade quase zero no denominador uma única bola ali já dominaria
+// o qui-quadrado. Média, variância e assimetria usam o slot original.
+
+#define RUNSTATS_MIN_PROB 1e-12   // slots com probabilidade até isto são juntados ao vizinho
+
+typedef struct {
+    double sum, carry;   // soma compensada
+} KahanSum;
+
+typedef struct {
+    int                 slotCount;
+    unsigned long long  n;
+    int                 binCount;   // grupos do qui-quadrado/KL (slots possíveis)
+    int                *binOf;      // slot -> grupo
+    unsigned long long *counts;     // por grupo
+    double             *expected;   // probabilidade esperada por grupo (soma 1)
+    double             *logExpected;
+
+    double   mean, m2, m3;          // momentos centrais acumulados (Welford/Terriberry)
+    KahanSum chiNum;                // soma de (c_i - n p_i)² / p_i
+    KahanSum countLogCount;         // soma de c_i ln c_i
+    KahanSum countLogExpected;      // soma de c_i ln p_i
+} RunStats;
+
+// 'expected' tem slotCount posições e é copiado (e renormalizado).
+// Retorna 0 em caso de sucesso, -1 se faltar memória.
+int  runStatsInit(RunStats *stats, int slotCount, const double *expected);
+void runStatsFree(RunStats *stats);
+
+// Zera as contagens, mantendo a distribuição esperada.
+void runStatsReset(RunStats *stats);
+
+// Uma bola aterrissou em 'slot'.
+void runStatsAdd(RunStats *stats, int slot);
+
+double runStatsMean(const RunStats *stats);
+double runStatsVariance(const RunStats *stats);   // amostral (n - 1)
+double runStatsSkewness(const RunStats *stats);
+double runStatsChiSquare(const RunStats *stats);  // graus de liberdade: binCount - 1
+double runStatsKl(const RunStats *stats);         // KL(empírica || esperada), em nats
+
+#endif
@@ -0,0 +1,278 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "profiler.h"
+#include "sim.h"
+#include "trace.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define SIM_FRESH 4            // bit do índice do meio: foto ainda não lida
+
+static void sleepSeconds(double seconds) {
+#ifdef _WIN32
+    DWORD ms = (DWORD)(seconds * 1000.0);
+    Sleep(ms > 0 ? ms : 1);
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t)seconds;
+    ts.tv_nsec = (long)((seconds - ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
+#endif
+}
+
+// Copia o estado para o buffer livre e o troca pelo do meio. As posições
+// da chuva vão direto para o buffer, sem passar por 'state'.
+static void publish(Simulation *sim) {
+    sim->state.serial++;
+    sim->state.time = profilerNow();
+    sim->state.accumulator = sim->clock.accumulator;
+    sim->state.rainEmitting = sim->rainOk && sim->rain.emitting;
+    sim->state.pinTests = sim->gamePinTests +
+                          (sim->rainOk ? sim->rain.store.pinTests : 0) +
+                          (sim->rolloutOk ? rolloutPinTests(&sim->rollout) : 0);
+    SimSnapshot *out = &sim->buffers[sim->back];
+    memcpy(out, &sim->state, offsetof(SimSnapshot, rainX));
+    out->rainCount = sim->rainOk ? rainPositions(&sim->rain, out->rainX, out->rainY, SIM_RAIN_CAPACITY) : 0;
+    int old = __atomic_exchange_n(&sim->middle, sim->back | SIM_FRESH, __ATOMIC_ACQ_REL);
+    sim->back = old & ~SIM_FRESH;
+}
+
+// Algum comando esperando? (a thread só dorme sem nenhum)
+static int hasCommands(Simulation *sim) {
+    return __atomic_load_n(&sim->stop, __ATOMIC_ACQUIRE) ||
+           __atomic_load_n(&sim->dropRequests, __ATOMIC_ACQUIRE) > 0 ||
+           __atomic_load_n(&sim->resetRequests, __ATOMIC_ACQUIRE) > 0 ||
+           (sim->rainOk && __atomic_load_n(&sim->rainRequest, __ATOMIC_ACQUIRE) != sim->rain.emitting);
+}
+
+// Acorda a thread depois de um comando. O lock garante que ela não está
+// entre testar hasCommands() e dormir, então o sinal não se perde.
+static void signalCommand(Simulation *sim) {
+    pthread_mutex_lock(&sim->lock);
+    pthread_cond_signal(&sim->wake);
+    pthread_mutex_unlock(&sim->lock);
+}
+
+static void handleCommands(Simulation *sim, int *changed) {
+    SimSnapshot *s = &sim->state;
+    if (__atomic_exchange_n(&sim->resetRequests, 0, __ATOMIC_ACQ_REL) > 0) {
+        memset(s->slotCounts, 0, sizeof(s->slotCounts));
+        s->totalBolas = 0;
+        runStatsReset(&sim->stats);
+        s->statsN = 0;
+        s->statsSerial++;
+        *changed = 1;
+    }
+    int rain = __atomic_load_n(&sim->rainRequest, __ATOMIC_ACQUIRE);
+    if (sim->rainOk && rain != sim->rain.emitting) {
+        rainSetEmitting(&sim->rain, rain);
+        *changed = 1;
+    }
+    if (__atomic_exchange_n(&sim->dropRequests, 0, __ATOMIC_ACQ_REL) > 0 && !s->ball.active) {
+        galtonSpawnBall(sim->board, &s->ball);
+        s->prevBall = s->ball;
+        galtonClockReset(&sim->clock);
+        predictionInvalidate(&sim->prediction);
+        sim->rolloutReady = 0;
+        sim->rolloutFirst = 0;
+        *changed = 1;
+    }
+}
+
+// Atualiza a estatística (antigo BLOCO 3 do main.c) e os números da foto
+static void countLanding(Simulation *sim, int slot) {
+    sim->state.slotCounts[slot]++;
+    sim->state.totalBolas++;
+    runStatsAdd(&sim->stats, slot);
+}
+
+static void updateStats(Simulation *sim) {
+    SimSnapshot *s = &sim->state;
+    s->statsN    = sim->stats.n;
+    s->mean      = runStatsMean(&sim->stats);
+    s->variance  = runStatsVariance(&sim->stats);
+    s->skewness  = runStatsSkewness(&sim->stats);
+    s->chiSquare = runStatsChiSquare(&sim->stats);
+    s->kl        = runStatsKl(&sim->stats);
+    s->statsSerial++;
+}
+
+static void land(Simulation *sim, int slot) {
+    countLanding(sim, slot);
+    updateStats(sim);
+    sim->state.landings++;
+    sim->state.lastSlot = slot;
+    traceInstant("bola aterrissou");
+}
+
+// Um passo da chuva; as estatísticas são recalculadas uma vez por passo,
+// não por bola
+static void stepRain(Simulation *sim) {
+    int landed = rainStep(&sim->rain, sim->board, GALTON_DT, &sim->rng, sim->landedSlots);
+    for (int i = 0; i < landed; i++) countLanding(sim, sim->landedSlots[i]);
+    if (landed > 0) updateStats(sim);
+}
+
+// Barras verdes: resultado do rollout.c quando já existe para esta queda,
+// senão a binomial de prediction.c
+static void updatePrediction(Simulation *sim) {
+    SimSnapshot *s = &sim->state;
+    int slotCount = sim->board->slotCount;
+    if (sim->rolloutOk && sim->rolloutFirst &&
+        rolloutPoll(&sim->rollout, sim->rolloutFirst, &sim->rolloutSerial, s->prediction)) {
+        sim->rolloutReady = 1;
+    }
+    if (!sim->rolloutReady) {
+        predictionUpdateForBall(&sim->prediction, sim->board, &s->ball);
+        memcpy(s->prediction, sim->prediction.slotProbs, sizeof(double) * slotCount);
+    }
+    s->hasPrediction = 1;
+}
+
+static void *simMain(void *arg) {
+    Simulation *sim = (Simulation *)arg;
+    SimSnapshot *s = &sim->state;
+    traceThreadName("simulacao");
+    double last = profilerNow();
+
+    while (!__atomic_load_n(&sim->stop, __ATOMIC_ACQUIRE)) {
+        int changed = 0;
+        handleCommands(sim, &changed);
+
+        double now = profilerNow();
+        float elapsed = (float)(now - last);
+        last = now;
+        int raining = sim->rainOk && (sim->rain.emitting || sim->rain.live > 0);
+        if (!s->ball.active && !raining) {
+            // Nada caindo: dorme até o próximo comando (sem acordar à toa)
+            if (changed) publish(sim);
+            pthread_mutex_lock(&sim->lock);
+            while (!hasCommands(sim)) pthread_cond_wait(&sim->wake, &sim->lock);
+            pthread_mutex_unlock(&sim->lock);
+            last = profilerNow();
+            continue;
+        }
+
+        // Física da bola (galton.c) e da chuva (rain.c), em passos fixos de GALTON_DT
+        int steps = galtonClockAdvance(&sim->clock, elapsed);
+        if (steps > 0) {
+            traceBegin("fisica");
+            double start = profilerNow();
+            for (int step = 0; step < steps; step++) {
+                if (s->ball.active) {
+                    s->prevBall = s->ball;
+                    sim->gamePinTests += galtonPinTests(sim->board, &s->ball);
+                    if (galtonStepBall(sim->board, &s->ball, GALTON_DT, &sim->rng)) land(sim, s->ball.slotIndex);
+                }
+                if (raining) stepRain(sim);
+            }
+            s->physicsMs += (profilerNow() - start) * 1000.0;
+            traceEnd("fisica");
+
+            if (s->ball.active && sim->rolloutOk) {
+                unsigned long id = rolloutSubmit(&sim->rollout, &s->ball);
+                if (!sim->rolloutFirst) sim->rolloutFirst = id;
+            }
+            changed = 1;
+        }
+        if (s->ball.active) updatePrediction(sim);
+        else s->hasPrediction = 0;
+        if (changed) publish(sim);
+
+        // Dorme até o próximo passo
+        double wait = sim->clock.step - sim->clock.accumulator - (profilerNow() - last);
+        if (wait > 0.0) sleepSeconds(wait);
+    }
+    return NULL;
+}
+
+int simInit(Simulation *sim, const GaltonBoard *board, const double *expected, unsigned long long seed) {
+    memset(sim, 0, sizeof(*sim));
+    if (board->slotCount > SIM_MAX_SLOTS) return -1;
+    sim->board = board;
+    sim->back = 0;
+    sim->middle = 1;
+    sim->front = 2;
+    rngSeed(&sim->rng, seed);
+    galtonClockInit(&sim->clock, GALTON_DT, GALTON_MAX_SUBSTEPS);
+
+    if (runStatsInit(&sim->stats, board->slotCount, expected) != 0) return -1;
+    if (predictionInit(&sim->prediction, board->slotCount) != 0) {
+        runStatsFree(&sim->stats);
+        return -1;
+    }
+    pthread_mutex_init(&sim->lock, NULL);
+    pthread_cond_init(&sim->wake, NULL);
+    // Sem o rollout a previsão fica só na binomial
+    sim->rolloutOk = rolloutInit(&sim->rollout, board, seed ^ 0x9E3779B97F4A7C15ULL) == 0;
+    // Sem memória para a chuva o jogo segue normal, só a tecla C não faz nada
+    sim->landedSlots = malloc(sizeof(int) * SIM_RAIN_CAPACITY);
+    sim->rainOk = sim->landedSlots &&
+                  rainInit(&sim->rain, SIM_RAIN_CAPACITY, SIM_RAIN_TARGET, SIM_RAIN_RATE) == 0;
+
+    if (pthread_create(&sim->thread, NULL, simMain, sim) != 0) {
+        if (sim->rainOk) rainFree(&sim->rain);
+        free(sim->landedSlots);
+        if (sim->rolloutOk) rolloutFree(&sim->rollout);
+        predictionFree(&sim->prediction);
+        runStatsFree(&sim->stats);
+        pthread_cond_destroy(&sim->wake);
+        pthread_mutex_destroy(&sim->lock);
+        return -1;
+    }
+    sim->running = 1;
+    return 0;
+}
+
+void simFree(Simulation *sim) {
+    if (!sim->running) return;
+    __atomic_store_n(&sim->stop, 1, __ATOMIC_RELEASE);
+    signalCommand(sim);
+    pthread_join(sim->thread, NULL);
+    pthread_cond_destroy(&sim->wake);
+    pthread_mutex_destroy(&sim->lock);
+    if (sim->rainOk) rainFree(&sim->rain);
+    free(sim->landedSlots);
+    if (sim->rolloutOk) rolloutFree(&sim->rollout);
+    predictionFree(&sim->prediction);
+    runStatsFree(&sim->stats);
+    sim->running = 0;
+}
+
+void simDropBall(Simulation *sim) {
+    __atomic_fetch_add(&sim->dropRequests, 1, __ATOMIC_ACQ_REL);
+    signalCommand(sim);
+}
+
+void simResetStats(Simulation *sim) {
+    __atomic_fetch_add(&sim->resetRequests, 1, __ATOMIC_ACQ_REL);
+    signalCommand(sim);
+}
+
+void simSetRain(Simulation *sim, int on) {
+    __atomic_store_n(&sim->rainRequest, on ? 1 : 0, __ATOMIC_RELEASE);
+    signalCommand(sim);
+}
+
+const SimSnapshot *simLatest(Simulation *sim) {
+    if (__atomic_load_n(&sim->middle, __ATOMIC_ACQUIRE) & SIM_FRESH) {
+        int old = __atomic_exchange_n(&sim->middle, sim->front, __ATOMIC_ACQ_REL);
+        sim->front = old & ~SIM_FRESH;
+    }
+    return &sim->buffers[sim->front];
+}
+
+float simAlpha(const SimSnapshot *snap, double now) {
+    float alpha = (snap->accumulator + (float)(now - snap->time)) / GALTON_DT;
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+    return alpha;
+}
@@ -0,0 +1,115 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <pthread.h>
+#include "galton.h"
+#include "prediction.h"
+#include "rain.h"
+#include "rollout.h"
+#include "runstats.h"
+
+// Simulação do jogo (bola, estatísticas e previsão) numa thread própria.
+// A física roda no passo fixo em tempo real, sem depender do FPS, e cada
+// mudança é publicada como uma "foto" imutável (SimSnapshot) num buffer
+// triplo sem lock: a thread da simulação escreve sempre num buffer livre e
+// o troca atomicamente pelo do meio; quem desenha pega o do meio quando
+// houver um novo. Nenhum dos dois espera o outro, então um frame lento não
+// atrasa a física e os dois rodam em núcleos diferentes.
+//
+// O jogo só fala com a simulação por comandos (soltar bola, zerar
+// estatísticas) e só lê as fotos.
+
+#define SIM_MAX_SLOTS 64
+#define SIM_RAIN_CAPACITY 16384   // bolas do modo chuva ao mesmo tempo, no máximo
+#define SIM_RAIN_TARGET   12000   // quantas o emissor mantém caindo
+#define SIM_RAIN_RATE     2500.0f // lançamentos por segundo, no máximo
+
+typedef struct {
+    unsigned long long serial;        // número da publicação
+    double    time;                   // profilerNow() na publicação
+    float     accumulator;            // tempo já passado do passo atual (s)
+    Ball      ball, prevBall;         // último passo e o anterior (interpolação)
+
+    unsigned long long slotCounts[SIM_MAX_SLOTS];  // 64 bits: a chuva passa de 2^31 em ~10 dias
+    unsigned long long totalBolas;
+    unsigned long long landings;      // aterrissagens da bola do jogo (não zera)
+    int       lastSlot;               // slot da última aterrissagem dela
+    unsigned long long statsSerial;   // muda a cada aterrissagem (jogo ou chuva) e ao zerar
+
+    unsigned long long statsN;        // runstats.c no momento da foto
+    double    mean, variance, skewness, chiSquare, kl;
+
+    double    prediction[SIM_MAX_SLOTS]; // barras verdes (se hasPrediction)
+    int       hasPrediction;
+
+    double    physicsMs;              // tempo gasto nos passos (acumulado)
+    long long pinTests;               // pinos testados: bola do jogo, chuva e rollout (acumulado)
+
+    // Modo chuva: posições das bolas caindo. Fica no fim porque a foto só
+    // copia as rainCount primeiras.
+    int       rainEmitting;
+    int       rainCount;
+    float     rainX[SIM_RAIN_CAPACITY];
+    float     rainY[SIM_RAIN_CAPACITY];
+} SimSnapshot;
+
+typedef struct {
+    const GaltonBoard *board;
+
+    // Buffer triplo
+    SimSnapshot buffers[3];
+    int         middle;       // índice | SIM_FRESH, trocado atomicamente
+    int         back;         // só a thread da simulação usa
+    int         front;        // só quem lê usa
+
+    // Comandos (atômicos). Quem manda um comando também sinaliza 'wake',
+    // onde a thread dorme enquanto não há nada caindo.
+    unsigned int dropRequests;
+    unsigned int resetRequests;
+    int          rainRequest;   // 1 = emitir, 0 = parar
+    int          stop;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+
+    pthread_t   thread;
+    int         running;
+
+    // Estado da simulação (só a thread da simulação mexe)
+    SimSnapshot       state;  // próxima foto, montada aos poucos (sem rainX/rainY)
+    Rng               rng;
+    GaltonClock       clock;
+    RunStats          stats;
+    Prediction        prediction;
+    RolloutPredictor  rollout;
+    int               rolloutOk;
+    unsigned long     rolloutFirst, rolloutSerial;  // primeiro pedido desta queda
+    int               rolloutReady;
+    RainEmitter       rain;
+    int               rainOk;
+    int              *landedSlots;  // aterrissagens da chuva num passo
+    long long         gamePinTests; // só os da bola do jogo
+} Simulation;
+
+// Inicia a thread. 'expected' é a distribuição das estatísticas (runstats.c).
+// Retorna 0 em caso de sucesso, -1 se faltar memória ou não conseguir a thread.
+int  simInit(Simulation *sim, const GaltonBoard *board, const double *expected, unsigned long long seed);
+
+// Para a thread e libera tudo.
+void simFree(Simulation *sim);
+
+// Comandos: soltam uma bola se nenhuma estiver caindo / zeram contagens e
+// estatísticas. Voltam na hora; o efeito aparece numa próxima foto.
+void simDropBall(Simulation *sim);
+void simResetStats(Simulation *sim);
+
+// Liga/desliga o emissor do modo chuva (rain.c). As aterrissagens entram
+// nas mesmas contagens e estatísticas da bola do jogo.
+void simSetRain(Simulation *sim, int on);
+
+// Foto mais recente. Continua válida até a próxima chamada.
+const SimSnapshot *simLatest(Simulation *sim);
+
+// Fração (0..1) do caminho entre prevBall e ball no instante 'now'.
+float simAlpha(const SimSnapshot *snap, double now);
+
+#endif
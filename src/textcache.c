@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "textcache.h"
+
+#define DEFAULT_FONT_SIZE 10   // tamanho base da fonte padrão do raylib
+#define LINE_SPACING 2         // espaço entre linhas do DrawText()
+
+static int quadsDrawn = 0;     // desde o último textCacheTakeDrawCount()
+
+int textCacheStale(CachedText *t, const void *id, long long key, int fontSize) {
+    if (t->valid && t->id == id && t->key == key && t->fontSize == fontSize) return 0;
+    t->id = id;
+    t->key = key;
+    t->fontSize = fontSize;
+    t->valid = 0;
+    return 1;
+}
+
+// Aumenta um vetor para 'needed' itens (só cresce). Retorna 0 ou -1.
+static int reserve(void **items, int *capacity, int needed, size_t itemSize) {
+    if (needed <= *capacity) return 0;
+    int bigger = *capacity > 0 ? *capacity : 32;
+    while (bigger < needed) bigger *= 2;
+    void *p = realloc(*items, itemSize * bigger);
+    if (!p) return -1;
+    *items = p;
+    *capacity = bigger;
+    return 0;
+}
+
+// Mesmo layout de DrawText() (que chama DrawTextEx com a fonte padrão)
+void textCacheSet(CachedText *t, const char *text) {
+    // Corta no começo de uma letra, nunca no meio de uma sequência UTF-8
+    int length = (int)strlen(text);
+    t->truncated = length > TEXT_CACHE_MAX - 1;
+    if (t->truncated) {
+        length = TEXT_CACHE_MAX - 1;
+        while (length > 0 && ((unsigned char)text[length] & 0xC0) == 0x80) length--;
+        TraceLog(LOG_WARNING, "TEXTCACHE: texto de %d bytes cortado em %d", (int)strlen(text), length);
+    }
+    if (reserve((void **)&t->text, &t->textCapacity, length + 1, sizeof(char)) != 0 ||
+        reserve((void **)&t->quads, &t->quadCapacity, length, sizeof(GlyphQuad)) != 0) {
+        TraceLog(LOG_WARNING, "TEXTCACHE: sem memória para %d bytes de texto", length);
+        t->valid = 0;
+        return;
+    }
+    memcpy(t->text, text, length);
+    t->text[length] = '\0';
+    t->width = MeasureText(t->text, t->fontSize);
+
+    Font font = GetFontDefault();
+    int fontSize = t->fontSize < DEFAULT_FONT_SIZE ? DEFAULT_FONT_SIZE : t->fontSize;
+    float spacing = (float)(fontSize / DEFAULT_FONT_SIZE);
+    float scale = (float)fontSize / font.baseSize;
+    float pad = (float)font.glyphPadding;
+    float offsetX = 0.0f, offsetY = 0.0f;
+
+    t->quadCount = 0;
+    for (int i = 0; t->text[i] != '\0';) {
+        int size = 0;
+        int codepoint = GetCodepointNext(&t->text[i], &size);
+        int index = GetGlyphIndex(font, codepoint);
+        i += size;
+
+        if (codepoint == '\n') {
+            offsetY += fontSize + LINE_SPACING;
+            offsetX = 0.0f;
+            continue;
+        }
+        Rectangle rec = font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            GlyphQuad *q = &t->quads[t->quadCount++];
+            q->src = (Rectangle){ rec.x - pad, rec.y - pad, rec.width + 2.0f * pad, rec.height + 2.0f * pad };
+            q->dst = (Rectangle){ offsetX + (font.glyphs[index].offsetX - pad) * scale,
+                                  offsetY + (font.glyphs[index].offsetY - pad) * scale,
+                                  q->src.width * scale, q->src.height * scale };
+        }
+        if (font.glyphs[index].advanceX == 0) offsetX += rec.width * scale + spacing;
+        else offsetX += font.glyphs[index].advanceX * scale + spacing;
+    }
+    t->valid = 1;
+}
+
+const CachedText *textCacheStatic(CachedText *t, const char *text, int fontSize) {
+    if (textCacheStale(t, text, 0, fontSize)) textCacheSet(t, text);
+    return t;
+}
+
+const CachedText *textCacheInt(CachedText *t, const char *fmt, long long value, int fontSize) {
+    if (textCacheStale(t, fmt, value, fontSize)) {
+        char buffer[TEXT_CACHE_FORMAT_MAX];
+        snprintf(buffer, sizeof(buffer), fmt, value);
+        textCacheSet(t, buffer);
+    }
+    return t;
+}
+
+void textCacheDraw(const CachedText *t, int x, int y, Color color) {
+    if (!t->valid) return;
+    Texture2D atlas = GetFontDefault().texture;
+    for (int i = 0; i < t->quadCount; i++) {
+        Rectangle dst = t->quads[i].dst;
+        dst.x += x;
+        dst.y += y;
+        DrawTexturePro(atlas, t->quads[i].src, dst, (Vector2){ 0, 0 }, 0.0f, color);
+    }
+    quadsDrawn += t->quadCount;
+}
+
+void textCacheFree(CachedText *t) {
+    free(t->text);
+    free(t->quads);
+    memset(t, 0, sizeof(*t));
+}
+
+int textCacheTakeDrawCount(void) {
+    int n = quadsDrawn;
+    quadsDrawn = 0;
+    return n;
+}
+
+void textCacheDrawCentered(const CachedText *t, int areaWidth, int y, Color color) {
+    textCacheDraw(t, (areaWidth - t->width) / 2, y, color);
+}
@@ -0,0 +1,54 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include "raylib.h"
+
+// Texto da interface guardado já pronto: a string só é formatada (e
+// medida) quando o valor que ela mostra muda, e cada letra já vira um
+// retângulo do atlas da fonte padrão. Desenhar é só colar esses retângulos,
+// sem TextFormat, MeasureText nem decodificar UTF-8 a cada frame.
+
+#define TEXT_CACHE_MAX 4096   // bytes do texto, no máximo; o resto é cortado (num limite de letra UTF-8)
+#define TEXT_CACHE_FORMAT_MAX 128  // bytes de um textCacheInt() formatado
+
+typedef struct {
+    Rectangle src;   // pedaço do atlas
+    Rectangle dst;   // posição relativa ao canto do texto
+} GlyphQuad;
+
+typedef struct {
+    const void *id;        // o que está sendo mostrado (string fixa ou formato)
+    long long   key;       // valor mostrado
+    int         fontSize;
+    int         valid;
+    char       *text;      // alocado e aumentado pelo textCacheSet()
+    int         textCapacity;
+    int         truncated; // 1 se o último texto passou de TEXT_CACHE_MAX
+    int         width;     // MeasureText(text, fontSize)
+    GlyphQuad  *quads;     // no máximo uma por byte do texto
+    int         quadCapacity;
+    int         quadCount;
+} CachedText;
+
+// Retorna 1 se (id, key, fontSize) mudou; nesse caso já guarda a chave nova
+// e quem chamou deve passar o texto novo para textCacheSet().
+int  textCacheStale(CachedText *t, const void *id, long long key, int fontSize);
+// Guarda o texto (cópia). Texto maior que TEXT_CACHE_MAX é cortado e avisado
+// no log do raylib; sem memória o texto fica inválido (não é desenhado).
+void textCacheSet(CachedText *t, const char *text);
+// Libera a memória do texto. Uma CachedText zerada ({0}) já pode ser usada.
+void textCacheFree(CachedText *t);
+
+// Atalhos: string fixa (a chave é o ponteiro) e um inteiro num formato
+// com "%lld" (a chave é o formato e o valor).
+const CachedText *textCacheStatic(CachedText *t, const char *text, int fontSize);
+const CachedText *textCacheInt(CachedText *t, const char *fmt, long long value, int fontSize);
+
+void textCacheDraw(const CachedText *t, int x, int y, Color color);
+// Centralizado horizontalmente numa área de largura 'areaWidth'
+void textCacheDrawCentered(const CachedText *t, int areaWidth, int y, Color color);
+
+// Letras coladas desde a última chamada (para o contador do profiler.c).
+int  textCacheTakeDrawCount(void);
+
+#endif
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "trace.h"
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+typedef struct {
+    const char *name;
+    double      ts;      // microssegundos
+    long long   value;   // contadores
+    char        phase;   // 'B', 'E', 'C' ou 'i' (como no formato do Chrome)
+} TraceEvent;
+
+// Anel de uma thread: só ela escreve em head, só traceWrite() escreve em
+// tail. Os dois índices crescem sem parar; a posição é índice & máscara.
+typedef struct {
+    TraceEvent   events[TRACE_RING_EVENTS];
+    unsigned int head;
+    unsigned int tail;
+    int          tid;
+    const char  *threadName;
+    long         dropped;
+} TraceRing;
+
+static TraceRing *rings[TRACE_MAX_THREADS];
+static int ringCount = 0;
+static int enabled = 0;
+static double origin = 0.0;
+static TraceRing noRing;   // sentinela: esta thread não conseguiu anel
+static THREAD_LOCAL TraceRing *localRing = NULL;
+static THREAD_LOCAL const char *localName = NULL;   // até o anel existir
+
+void traceSetEnabled(int on) {
+    if (on && origin == 0.0) origin = profilerNow();
+    __atomic_store_n(&enabled, on ? 1 : 0, __ATOMIC_RELEASE);
+}
+
+int traceEnabled(void) {
+    return __atomic_load_n(&enabled, __ATOMIC_ACQUIRE);
+}
+
+// Anel da thread atual, criado no primeiro uso. Se não deu (tabela cheia
+// ou sem memória) a thread guarda a sentinela e não tenta de novo, para não
+// mexer no contador compartilhado a cada evento.
+static TraceRing *threadRing(void) {
+    if (localRing) return localRing != &noRing ? localRing : NULL;
+    localRing = &noRing;
+    int slot = __atomic_fetch_add(&ringCount, 1, __ATOMIC_ACQ_REL);
+    if (slot >= TRACE_MAX_THREADS) return NULL;
+    TraceRing *ring = calloc(1, sizeof(TraceRing));
+    if (!ring) return NULL;
+    ring->tid = slot + 1;
+    ring->threadName = localName;
+    __atomic_store_n(&rings[slot], ring, __ATOMIC_RELEASE);
+    localRing = ring;
+    return ring;
+}
+
+static void record(const char *name, char phase, long long value) {
+    if (!traceEnabled()) return;
+    TraceRing *ring = threadRing();
+    if (!ring) return;
+    unsigned int head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= TRACE_RING_EVENTS) {
+        __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    TraceEvent *e = &ring->events[head & (TRACE_RING_EVENTS - 1)];
+    e->name = name;
+    e->ts = (profilerNow() - origin) * 1e6;
+    e->value = value;
+    e->phase = phase;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// O anel só é criado no primeiro evento, então threads que nunca gravam
+// não gastam memória
+void traceThreadName(const char *name) {
+    localName = name;
+    if (localRing && localRing != &noRing) localRing->threadName = name;
+}
+
+void traceBegin(const char *name)                  { record(name, 'B', 0); }
+void traceEnd(const char *name)                    { record(name, 'E', 0); }
+void traceCounter(const char *name, long long value) { record(name, 'C', value); }
+void traceInstant(const char *name)                { record(name, 'i', 0); }
+
+long traceWrite(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+    long written = 0;
+    int count = __atomic_load_n(&ringCount, __ATOMIC_ACQUIRE);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    const char *sep = "";
+    for (int r = 0; r < count; r++) {
+        TraceRing *ring = __atomic_load_n(&rings[r], __ATOMIC_ACQUIRE);
+        if (!ring) continue;
+        if (ring->threadName) {
+            fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    sep, ring->tid, ring->threadName);
+            sep = ",\n";
+        }
+        unsigned int head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        unsigned int tail = ring->tail;
+        for (; tail != head; tail++) {
+            const TraceEvent *e = &ring->events[tail & (TRACE_RING_EVENTS - 1)];
+            if (e->phase == 'C') {
+                fprintf(f, "%s{\"ph\":\"C\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                        sep, e->name, ring->tid, e->ts, e->value);
+            } else if (e->phase == 'i') {
+                fprintf(f, "%s{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                        sep, e->name, ring->tid, e->ts);
+            } else {
+                fprintf(f, "%s{\"ph\":\"%c\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                        sep, e->phase, e->name, ring->tid, e->ts);
+            }
+            sep = ",\n";
+            written++;
+        }
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return written;
+}
+
+long traceDropped(void) {
+    long dropped = 0;
+    int count = __atomic_load_n(&ringCount, __ATOMIC_ACQUIRE);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+    for (int r = 0; r < count; r++) {
+        TraceRing *ring = __atomic_load_n(&rings[r], __ATOMIC_ACQUIRE);
+        if (ring) dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    }
+    return dropped;
+}
+
+void traceShutdown(void) {
+    int count = __atomic_load_n(&ringCount, __ATOMIC_ACQUIRE);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+    for (int r = 0; r < count; r++) {
+        free(rings[r]);
+        rings[r] = NULL;
+    }
+    ringCount = 0;
+    localRing = NULL;
+}
@@ -0,0 +1,44 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Rastro de eventos para ver depois num visualizador (chrome://tracing ou
+// ui.perfetto.dev), no formato JSON "trace event" do Chrome.
+//
+// Cada thread grava num anel próprio (um produtor, sem lock): gravar um
+// evento custa ler o relógio e escrever 32 bytes. traceWrite() esvazia os
+// anéis de todas as threads num arquivo. Com a gravação desligada as
+// chamadas só leem uma flag.
+//
+// Os nomes precisam ser strings fixas (literais): só o ponteiro é guardado.
+
+#define TRACE_RING_EVENTS (1 << 16)  // eventos por thread (potência de 2)
+#define TRACE_MAX_THREADS 64
+
+// Liga/desliga a gravação (começa desligada).
+void traceSetEnabled(int enabled);
+int  traceEnabled(void);
+
+// Nome da thread atual no visualizador.
+void traceThreadName(const char *name);
+
+// Zona: tudo entre traceBegin e traceEnd do mesmo nome, na mesma thread.
+void traceBegin(const char *name);
+void traceEnd(const char *name);
+
+// Valor de um contador (vira um gráfico no visualizador).
+void traceCounter(const char *name, long long value);
+
+// Marca pontual.
+void traceInstant(const char *name);
+
+// Escreve os eventos gravados até agora em 'path' e esvazia os anéis.
+// Retorna quantos eventos foram escritos, ou -1 se não conseguiu abrir o arquivo.
+long traceWrite(const char *path);
+
+// Eventos perdidos porque o anel de alguma thread encheu.
+long traceDropped(void);
+
+// Libera os anéis. Só depois que as outras threads pararam de gravar.
+void traceShutdown(void);
+
+#endif